@@ -0,0 +1,178 @@
+#include <thread>
+
+#include "concurrent_stack.h"
+
+//-------------------------------------------------------------------------------------------
+//! Benchmark of lock-free stack under contention
+//!
+//! @note Usage: concurrent_stack_bench [threads] [count]. Every thread pushes count elements
+//!       and pops after every push or after every burst, then sum of pushed elements is
+//!       compared with sum of popped and left ones. Output is CSV, one line per runner:
+//!       runner,type,threads,count,ops,ns_per_op
+//-------------------------------------------------------------------------------------------
+
+const int32_t BENCH_DEFAULT_THREADS = 16;
+const int32_t BENCH_DEFAULT_COUNT   = 1 << 15;
+const int32_t BENCH_MAX_THREADS     = 256;
+const int32_t BENCH_BURST_SIZE      = 64;
+
+static std::atomic<uint64_t> benchPushedSum = {};
+static std::atomic<uint64_t> benchPoppedSum = {};
+
+//-------------------------------------------------------------------------------------------
+//! Result of one runner
+//-------------------------------------------------------------------------------------------
+
+struct BenchResult {
+    uint64_t ops;
+    uint64_t timeNs;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Makes count pairs of push and pop
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void RunPairsThread(ConcurrentStack<T>* stack, int32_t count) {
+    uint64_t pushedSum = 0;
+    uint64_t poppedSum = 0;
+
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        T poppedValue = {};
+
+        ConcurrentStackPush(stack, (T)curIdx);
+        pushedSum += (uint64_t)curIdx;
+
+        if (ConcurrentStackPop(stack, &poppedValue) == NO_ERROR) poppedSum += (uint64_t)poppedValue;
+    }
+
+    benchPushedSum.fetch_add(pushedSum, std::memory_order_relaxed);
+    benchPoppedSum.fetch_add(poppedSum, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Pushes count elements in bursts of BENCH_BURST_SIZE and pops the same amount after each
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void RunBurstsThread(ConcurrentStack<T>* stack, int32_t count) {
+    uint64_t pushedSum = 0;
+    uint64_t poppedSum = 0;
+
+    for (int32_t burstBegin = 0; burstBegin < count; burstBegin += BENCH_BURST_SIZE) {
+        int32_t burstEnd = burstBegin + BENCH_BURST_SIZE;
+        if (burstEnd > count) burstEnd = count;
+
+        for (int32_t curIdx = burstBegin; curIdx < burstEnd; curIdx++) {
+            ConcurrentStackPush(stack, (T)curIdx);
+            pushedSum += (uint64_t)curIdx;
+        }
+
+        for (int32_t curIdx = burstBegin; curIdx < burstEnd; curIdx++) {
+            T poppedValue = {};
+
+            if (ConcurrentStackPop(stack, &poppedValue) == NO_ERROR) poppedSum += (uint64_t)poppedValue;
+        }
+    }
+
+    benchPushedSum.fetch_add(pushedSum, std::memory_order_relaxed);
+    benchPoppedSum.fetch_add(poppedSum, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures runner on threadsCount threads and checks that no element was lost
+//!
+//! @return Result of runner, ops is 0 if sums don't match
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+BenchResult BenchThreads(void (*runner)(ConcurrentStack<T>*, int32_t),
+                         int32_t threadsCount, int32_t count) {
+    ConcurrentStackCtor(stack, T);
+
+    benchPushedSum.store(0, std::memory_order_relaxed);
+    benchPoppedSum.store(0, std::memory_order_relaxed);
+
+    std::thread threads[BENCH_MAX_THREADS];
+
+    uint64_t beginTime = GetTimeNs();
+
+    for (int32_t curThread = 0; curThread < threadsCount; curThread++) {
+        threads[curThread] = std::thread(runner, &stack, count);
+    }
+
+    for (int32_t curThread = 0; curThread < threadsCount; curThread++) {
+        threads[curThread].join();
+    }
+
+    uint64_t endTime = GetTimeNs();
+
+    uint64_t leftSum     = 0;
+    T        poppedValue = {};
+    while (ConcurrentStackPop(&stack, &poppedValue) == NO_ERROR) leftSum += (uint64_t)poppedValue;
+
+    ConcurrentStackDtor(&stack);
+
+    uint64_t pushedSum = benchPushedSum.load(std::memory_order_relaxed);
+    uint64_t poppedSum = benchPoppedSum.load(std::memory_order_relaxed);
+
+    if (pushedSum != poppedSum + leftSum) {
+        fprintf(stderr, "Sum check failed: pushed %llu, popped %llu, left %llu\n",
+                (unsigned long long)pushedSum, (unsigned long long)poppedSum,
+                (unsigned long long)leftSum);
+
+        return { 0, endTime - beginTime };
+    }
+
+    return { (uint64_t)threadsCount * count * 2, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+void PrintBenchResult(const char* runner, const char* type, int32_t threadsCount, int32_t count,
+                      BenchResult result) {
+    printf("%s,%s,%d,%d,%llu,%.2lf\n", runner, type, threadsCount, count,
+           (unsigned long long)result.ops,
+           result.ops ? (double)result.timeNs / (double)result.ops : 0.0);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs both runners for one element type
+//!
+//! @return true if sums of both runners match
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool RunBench(int32_t threadsCount, int32_t count) {
+    const char* type = StackElemInfo<T>::NAME;
+
+    BenchResult pairs  = BenchThreads<T>(RunPairsThread<T>,  threadsCount, count);
+    PrintBenchResult("pairs",  type, threadsCount, count, pairs);
+
+    BenchResult bursts = BenchThreads<T>(RunBurstsThread<T>, threadsCount, count);
+    PrintBenchResult("bursts", type, threadsCount, count, bursts);
+
+    return pairs.ops != 0 && bursts.ops != 0;
+}
+
+int main(int argc, char* argv[]) {
+    int32_t threadsCount = BENCH_DEFAULT_THREADS;
+    int32_t count        = BENCH_DEFAULT_COUNT;
+
+    if (argc > 1) threadsCount = atoi(argv[1]);
+    if (argc > 2) count        = atoi(argv[2]);
+
+    if (threadsCount <= 0 || threadsCount > BENCH_MAX_THREADS || count <= 0) {
+        fprintf(stderr, "Usage: %s [threads] [count]\n", argv[0]);
+        return 1;
+    }
+
+    printf("runner,type,threads,count,ops,ns_per_op\n");
+
+    bool isOk = RunBench<int64_t>(threadsCount, count);
+    isOk     &= RunBench<double> (threadsCount, count);
+
+    return isOk ? 0 : 1;
+}
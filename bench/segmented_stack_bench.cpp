@@ -0,0 +1,146 @@
+#include "segmented_stack.h"
+
+//-------------------------------------------------------------------------------------------
+//! Benchmark of segmented stack on every protection level
+//!
+//! @note Usage: segmented_stack_bench [count]. Every popped element is compared with the
+//!       pushed one, so run fails if stack loses or reorders elements. Output is CSV, one
+//!       line per workload:
+//!       workload,type,level,count,ops,ns_per_op
+//-------------------------------------------------------------------------------------------
+
+const int32_t BENCH_DEFAULT_COUNT  = 1 << 16;
+const int32_t BENCH_BORDER_ROUNDS  = 1 << 12;
+
+//-------------------------------------------------------------------------------------------
+//! Result of one workload
+//-------------------------------------------------------------------------------------------
+
+struct BenchResult {
+    uint64_t ops;
+    uint64_t timeNs;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Measures count pushes and full drain, every popped element is checked
+//!
+//! @return Result of workload, ops is 0 if popped element differs from pushed one
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchFill(int32_t count) {
+    SegmentedStackCtorType(stack, T, Level);
+
+    bool isOk = true;
+
+    uint64_t beginTime = GetTimeNs();
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        SegmentedStackPush(&stack, (T)curIdx);
+    }
+
+    for (int32_t curIdx = count - 1; curIdx >= 0; curIdx--) {
+        isOk &= SegmentedStackPop(&stack) == (T)curIdx;
+    }
+    uint64_t endTime   = GetTimeNs();
+
+    SegmentedStackDtor(&stack);
+
+    return { isOk ? 2 * (uint64_t)count : 0, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures pushes and pops which cross chunk border back and forth
+//!
+//! @return Result of workload, ops is 0 if popped element differs from pushed one
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchBorder(int32_t count) {
+    (void)count;
+
+    SegmentedStackCtorType(stack, T, Level);
+
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+
+    for (int64_t curIdx = 0; curIdx < capacity - 1; curIdx++) {
+        SegmentedStackPush(&stack, (T)curIdx);
+    }
+
+    bool isOk = true;
+
+    uint64_t beginTime = GetTimeNs();
+    for (int32_t curRound = 0; curRound < BENCH_BORDER_ROUNDS; curRound++) {
+        SegmentedStackPush(&stack, (T)curRound);
+        SegmentedStackPush(&stack, (T)(curRound + 1));
+
+        isOk &= SegmentedStackPop(&stack) == (T)(curRound + 1);
+        isOk &= SegmentedStackPop(&stack) == (T)curRound;
+    }
+    uint64_t endTime   = GetTimeNs();
+
+    isOk &= IsAllOk(&stack) == NO_ERROR && stack.size == capacity - 1;
+
+    SegmentedStackDtor(&stack);
+
+    return { isOk ? 4 * (uint64_t)BENCH_BORDER_ROUNDS : 0, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+void PrintBenchResult(const char* workload, const char* type, int level, int32_t count,
+                      BenchResult result) {
+    printf("%s,%s,%d,%d,%llu,%.2lf\n", workload, type, level, count,
+           (unsigned long long)result.ops,
+           result.ops ? (double)result.timeNs / (double)result.ops : 0.0);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all workloads for one element type on one level
+//!
+//! @return true if all workloads got back pushed elements
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool RunBench(int32_t count) {
+    const char* type = StackElemInfo<T>::NAME;
+
+    BenchResult fill   = BenchFill  <T, Level>(count);
+    PrintBenchResult("fill",   type, Level, count, fill);
+
+    BenchResult border = BenchBorder<T, Level>(count);
+    PrintBenchResult("border", type, Level, count, border);
+
+    return fill.ops != 0 && border.ops != 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all workloads for one element type on every level
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool RunBenchLevels(int32_t count) {
+    bool isOk = RunBench<T, LOW_LEVEL> (count);
+    isOk     &= RunBench<T, MID_LEVEL> (count);
+    isOk     &= RunBench<T, HIGH_LEVEL>(count);
+
+    return isOk;
+}
+
+int main(int argc, char* argv[]) {
+    int32_t count = BENCH_DEFAULT_COUNT;
+    if (argc > 1) count = atoi(argv[1]);
+
+    if (count <= 0) {
+        fprintf(stderr, "Usage: %s [count]\n", argv[0]);
+        return 1;
+    }
+
+    printf("workload,type,level,count,ops,ns_per_op\n");
+
+    bool isOk = RunBenchLevels<int32_t>(count);
+    isOk     &= RunBenchLevels<double> (count);
+
+    return isOk ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+#include "stack.h"
+
+//-------------------------------------------------------------------------------------------
+//! Benchmark of stack operations on every protection level and element type
+//!
+//! @note Usage: stack_bench [count]. Output is CSV, one line per workload:
+//!       workload,type,level,hash_check,count,ops,ns_per_op
+//-------------------------------------------------------------------------------------------
+
+const int32_t BENCH_DEFAULT_COUNT = 1024;
+const int32_t BENCH_LARGE_FACTOR  = 16;
+const int32_t BENCH_BURSTS_COUNT  = 16;
+
+static volatile uint64_t benchSink = 0;
+
+//-------------------------------------------------------------------------------------------
+//! Result of one workload
+//-------------------------------------------------------------------------------------------
+
+struct BenchResult {
+    uint64_t ops;
+    uint64_t timeNs;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Makes count-th element value
+//!
+//! @param [in] count Number of element
+//!
+//! @return Element
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+T GetBenchElem(int32_t count) {
+    return (T)count;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Consumes popped element so compiler can't throw pops away
+//!
+//! @param [in] elem Popped element
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void ConsumeBenchElem(T elem) {
+    benchSink = benchSink + (uint64_t)elem;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures count pushes into empty stack
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchPush(int32_t count) {
+    StackCtorType(stack, T, Level);
+
+    uint64_t beginTime = GetTimeNs();
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        StackPush(&stack, GetBenchElem<T>(curIdx));
+    }
+    uint64_t endTime   = GetTimeNs();
+
+    StackDtor(&stack);
+
+    return { (uint64_t)count, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures count pops from full stack
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchPop(int32_t count) {
+    StackCtorType(stack, T, Level);
+
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        StackPush(&stack, GetBenchElem<T>(curIdx));
+    }
+
+    uint64_t beginTime = GetTimeNs();
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        ConsumeBenchElem(StackPop(&stack));
+    }
+    uint64_t endTime   = GetTimeNs();
+
+    StackDtor(&stack);
+
+    return { (uint64_t)count, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures 2 * count random pushes and pops around half full stack
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchMixed(int32_t count) {
+    StackCtorType(stack, T, Level);
+
+    for (int32_t curIdx = 0; curIdx < count / 2; curIdx++) {
+        StackPush(&stack, GetBenchElem<T>(curIdx));
+    }
+
+    uint64_t randomState = 0x9E3779B97F4A7C15;
+    uint64_t ops         = 2 * (uint64_t)count;
+
+    uint64_t beginTime = GetTimeNs();
+    for (uint64_t curOp = 0; curOp < ops; curOp++) {
+        if (stack.size == 0 || GetRandom(&randomState) % 2 == 0)
+            StackPush(&stack, GetBenchElem<T>((int32_t)curOp));
+        else
+            ConsumeBenchElem(StackPop(&stack));
+    }
+    uint64_t endTime   = GetTimeNs();
+
+    StackDtor(&stack);
+
+    return { ops, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures bursts of count pushes followed by count pops, so stack grows and shrinks
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchBursty(int32_t count) {
+    StackCtorType(stack, T, Level);
+
+    uint64_t beginTime = GetTimeNs();
+    for (int32_t curBurst = 0; curBurst < BENCH_BURSTS_COUNT; curBurst++) {
+        for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+            StackPush(&stack, GetBenchElem<T>(curIdx));
+        }
+
+        for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+            ConsumeBenchElem(StackPop(&stack));
+        }
+    }
+    uint64_t endTime   = GetTimeNs();
+
+    StackDtor(&stack);
+
+    return { 2 * (uint64_t)BENCH_BURSTS_COUNT * count, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures the same bursts as BenchBursty with fast operations inside StackVerifyScope
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchScoped(int32_t count) {
+    StackCtorType(stack, T, Level);
+
+    uint64_t beginTime = GetTimeNs();
+    for (int32_t curBurst = 0; curBurst < BENCH_BURSTS_COUNT; curBurst++) {
+        StackVerifyScope scope(&stack);
+
+        for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+            StackPushFast(&stack, GetBenchElem<T>(curIdx));
+        }
+
+        for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+            ConsumeBenchElem(StackPopFast(&stack));
+        }
+    }
+    uint64_t endTime   = GetTimeNs();
+
+    StackDtor(&stack);
+
+    return { 2 * (uint64_t)BENCH_BURSTS_COUNT * count, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures bursts inside StackVerifyScope where fast pops are mixed with StackPop
+//!
+//! @note StackPop shrinks stack inside scope after fast pops left its hashes stale
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchScopedMixed(int32_t count) {
+    StackCtorType(stack, T, Level);
+
+    int32_t fastCount = count * 6 / 10;
+
+    uint64_t beginTime = GetTimeNs();
+    for (int32_t curBurst = 0; curBurst < BENCH_BURSTS_COUNT; curBurst++) {
+        for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+            StackPush(&stack, GetBenchElem<T>(curIdx));
+        }
+
+        StackVerifyScope scope(&stack);
+
+        for (int32_t curIdx = 0; curIdx < fastCount; curIdx++) {
+            ConsumeBenchElem(StackPopFast(&stack));
+        }
+
+        for (int32_t curIdx = fastCount; curIdx < count; curIdx++) {
+            ConsumeBenchElem(StackPop(&stack));
+        }
+    }
+    uint64_t endTime   = GetTimeNs();
+
+    StackDtor(&stack);
+
+    return { 2 * (uint64_t)BENCH_BURSTS_COUNT * count, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures fill of BENCH_LARGE_FACTOR * count elements and full drain
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchLarge(int32_t count) {
+    StackCtorType(stack, T, Level);
+
+    int32_t largeCount = count * BENCH_LARGE_FACTOR;
+
+    uint64_t beginTime = GetTimeNs();
+    for (int32_t curIdx = 0; curIdx < largeCount; curIdx++) {
+        StackPush(&stack, GetBenchElem<T>(curIdx));
+    }
+
+    for (int32_t curIdx = 0; curIdx < largeCount; curIdx++) {
+        ConsumeBenchElem(StackPop(&stack));
+    }
+    uint64_t endTime   = GetTimeNs();
+
+    StackDtor(&stack);
+
+    return { 2 * (uint64_t)largeCount, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+void PrintBenchResult(const char* workload, const char* type, int level, int32_t count,
+                      BenchResult result) {
+    printf("%s,%s,%d,%s,%d,%llu,%.2lf\n",
+           workload, type, level,
+           (STACK_HASH_CHECK == DIRTY_HASH_CHECK) ? "dirty" : "full",
+           count, (unsigned long long)result.ops,
+           (double)result.timeNs / (double)result.ops);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all workloads for one element type and level
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+void RunBench(int32_t count) {
+    const char* type = StackElemInfo<T>::NAME;
+
+    PrintBenchResult("push",   type, Level, count, BenchPush  <T, Level>(count));
+    PrintBenchResult("pop",    type, Level, count, BenchPop   <T, Level>(count));
+    PrintBenchResult("mixed",  type, Level, count, BenchMixed <T, Level>(count));
+    PrintBenchResult("bursty", type, Level, count, BenchBursty<T, Level>(count));
+    PrintBenchResult("scoped", type, Level, count, BenchScoped<T, Level>(count));
+    PrintBenchResult("scoped_mixed", type, Level, count, BenchScopedMixed<T, Level>(count));
+    PrintBenchResult("large",  type, Level, count, BenchLarge <T, Level>(count));
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all workloads for one element type on every level
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void RunBenchLevels(int32_t count) {
+    RunBench<T, LOW_LEVEL> (count);
+    RunBench<T, MID_LEVEL> (count);
+    RunBench<T, HIGH_LEVEL>(count);
+}
+
+int main(int argc, char* argv[]) {
+    int32_t count = BENCH_DEFAULT_COUNT;
+    if (argc > 1) count = atoi(argv[1]);
+
+    if (count <= 0) {
+        fprintf(stderr, "Usage: %s [count]\n", argv[0]);
+        return 1;
+    }
+
+    printf("workload,type,level,hash_check,count,ops,ns_per_op\n");
+
+    RunBenchLevels<int32_t>(count);
+    RunBenchLevels<int64_t>(count);
+    RunBenchLevels<double> (count);
+
+    fprintf(stderr, "sink %llu\n", (unsigned long long)benchSink);
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include <unistd.h>
+
+#include "stack_file.h"
+
+//-------------------------------------------------------------------------------------------
+//! Check of stack in mapped file on every protection level
+//!
+//! @note Usage: stack_file_check [count]. Stack is created in temporary file, closed and
+//!       reopened, then corrupted files must be rejected and clone must not touch the file.
+//!       Output is CSV, one line per check:
+//!       check,type,level,count,result
+//-------------------------------------------------------------------------------------------
+
+const int32_t CHECK_DEFAULT_COUNT = 1 << 12;
+const size_t  CHECK_PATH_SIZE     = 64;
+
+//-------------------------------------------------------------------------------------------
+//! Creates stack in file with count elements and closes it
+//!
+//! @return true if file is created
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool CreateCheckFile(const char* path, int32_t count) {
+    Stack<T, Level> stack = {};
+    StackFile       file  = {};
+
+    if (StackFileCreate_(&stack, &file, path LOCATION (stack)) != 0) return false;
+
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        StackPush(&stack, (T)curIdx);
+    }
+
+    return StackFileClose(&stack) == 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Opens file and pops all its elements
+//!
+//! @return true if file is opened and keeps count pushed elements
+//!
+//! @note Pops shrink file without sync, so file can't be reopened after this check
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool IsCheckFileOk(const char* path, int32_t count) {
+    Stack<T, Level> stack = {};
+    StackFile       file  = {};
+
+    if (StackFileOpen_(&stack, &file, path LOCATION (stack)) != 0) return false;
+
+    bool isOk = stack.size == count;
+
+    for (int32_t curIdx = count - 1; isOk && curIdx >= 0; curIdx--) {
+        isOk &= StackPop(&stack) == (T)curIdx;
+    }
+
+    StackDtor(&stack);
+
+    return isOk;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Opens file expecting it to be rejected
+//!
+//! @return true if open fails
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool IsCheckFileRejected(const char* path) {
+    Stack<T, Level> stack = {};
+    StackFile       file  = {};
+
+    if (StackFileOpen_(&stack, &file, path LOCATION (stack)) != 0) return true;
+
+    StackDtor(&stack);
+
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Flips one bit of file
+//!
+//! @return true if file is changed
+//-------------------------------------------------------------------------------------------
+
+static bool FlipCheckFileBit(const char* path, long offset) {
+    FILE* file = fopen(path, "r+b");
+    if (file == nullptr) return false;
+
+    int byte = EOF;
+    if (fseek(file, offset, SEEK_SET) == 0) byte = fgetc(file);
+
+    bool isFlipped = byte != EOF && fseek(file, offset, SEEK_SET) == 0 &&
+                     fputc(byte ^ 0x10, file) != EOF;
+
+    return fclose(file) == 0 && isFlipped;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Clones stack in file and changes clone
+//!
+//! @return true if clone is in malloc memory and file keeps count pushed elements
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool IsCloneOk(const char* path, int32_t count) {
+    Stack<T, Level> stack = {};
+    StackFile       file  = {};
+
+    if (StackFileOpen_(&stack, &file, path LOCATION (stack)) != 0) return false;
+
+    StackClone(clone, stack);
+
+    bool isOk = clone.allocator.allocate == MallocAllocate && clone.size == count;
+
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        StackPush(&clone, (T)-curIdx);
+    }
+
+    StackDtor(&clone);
+
+    isOk &= StackFileClose(&stack) == 0;
+
+    return isOk && IsCheckFileOk<T, Level>(path, count);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+static void PrintCheckResult(const char* check, const char* type, int level, int32_t count,
+                             bool isOk) {
+    printf("%s,%s,%d,%d,%s\n", check, type, level, count, isOk ? "ok" : "failed");
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all checks for one element type on one level
+//!
+//! @return true if all checks passed
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool RunCheck(const char* path, int32_t count) {
+    const char* type = StackElemInfo<T>::NAME;
+
+    bool reopen = CreateCheckFile<T, Level>(path, count) && IsCheckFileOk<T, Level>(path, count);
+    PrintCheckResult("reopen", type, Level, count, reopen);
+
+    bool clone  = CreateCheckFile<T, Level>(path, count) && IsCloneOk<T, Level>(path, count);
+    PrintCheckResult("clone",  type, Level, count, clone);
+
+    bool header = CreateCheckFile<T, Level>(path, count) &&
+                  FlipCheckFileBit(path, offsetof(StackFileHeader, size)) &&
+                  IsCheckFileRejected<T, Level>(path);
+    PrintCheckResult("header", type, Level, count, header);
+
+    bool isOk = reopen && clone && header;
+
+    // Only HIGH level keeps data hash, lower levels can't notice changed element
+    if (Level >= HIGH_LEVEL) {
+        long dataOffset = FILE_HEADER_SIZE + GetShift(Level) + (count / 2) * sizeof(T);
+
+        bool data = CreateCheckFile<T, Level>(path, count) &&
+                    FlipCheckFileBit(path, dataOffset) &&
+                    IsCheckFileRejected<T, Level>(path);
+        PrintCheckResult("data", type, Level, count, data);
+
+        isOk &= data;
+    }
+
+    return isOk;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all checks for one element type on every level
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool RunCheckLevels(const char* path, int32_t count) {
+    bool isOk = RunCheck<T, LOW_LEVEL> (path, count);
+    isOk     &= RunCheck<T, MID_LEVEL> (path, count);
+    isOk     &= RunCheck<T, HIGH_LEVEL>(path, count);
+
+    return isOk;
+}
+
+int main(int argc, char* argv[]) {
+    int32_t count = CHECK_DEFAULT_COUNT;
+    if (argc > 1) count = atoi(argv[1]);
+
+    if (count <= 0) {
+        fprintf(stderr, "Usage: %s [count]\n", argv[0]);
+        return 1;
+    }
+
+    char path[CHECK_PATH_SIZE] = "/tmp/stack_file_check_XXXXXX";
+
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "Can't create temporary file\n");
+        return 1;
+    }
+    close(fd);
+
+    printf("check,type,level,count,result\n");
+
+    bool isOk = RunCheckLevels<int32_t>(path, count);
+    isOk     &= RunCheckLevels<double> (path, count);
+
+    unlink(path);
+
+    return isOk ? 0 : 1;
+}
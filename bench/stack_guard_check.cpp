@@ -0,0 +1,176 @@
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "stack_guard.h"
+
+//-------------------------------------------------------------------------------------------
+//! Check of guarded stacks on every protection level
+//!
+//! @note Usage: stack_guard_check [count]. Child process pushes count elements to guarded
+//!       stack and writes after its data, it must die by SIGSEGV with dump of the stack.
+//!       Then stacks are registered and destroyed with StackDtor more times than registry
+//!       holds, so any entry left after StackDtor fills it. Output is CSV, one line per check:
+//!       check,type,level,count,result
+//-------------------------------------------------------------------------------------------
+
+const int32_t CHECK_DEFAULT_COUNT = 1 << 12;
+const size_t  CHECK_OUTPUT_SIZE   = 1 << 16;
+
+const char* const CHECK_HIT_MESSAGE = "Guard page of stack was hit";
+
+static char checkOutput[CHECK_OUTPUT_SIZE];
+
+//-------------------------------------------------------------------------------------------
+//! Pushes count elements to guarded stack and writes the first byte after its data
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+void RunOverrunChild(int32_t count) {
+    StackCtorGuard(stack, T, Level);
+
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        StackPush(&stack, (T)curIdx);
+    }
+
+    uintptr_t blockEnd   = (uintptr_t)(stack.data - StackShift(&stack)) +
+                           stack.capacity * sizeof(T) + StackProtectionSize(&stack);
+    uintptr_t rightGuard = (blockEnd + ALLOC_ALIGNMENT - 1) / ALLOC_ALIGNMENT * ALLOC_ALIGNMENT;
+
+    *(volatile uint8_t*)rightGuard = 0;
+
+    StackGuardDtor(&stack);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs overrun in child process and reads its stderr
+//!
+//! @return true if child died by SIGSEGV and printed guard page message
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool IsOverrunCaught(int32_t count) {
+    int pipeFds[2] = {};
+    if (pipe(pipeFds) != 0) return false;
+
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t child = fork();
+    if (child < 0) return false;
+
+    if (child == 0) {
+        close(pipeFds[0]);
+        dup2(pipeFds[1], STDERR_FILENO);
+
+        RunOverrunChild<T, Level>(count);
+
+        _exit(0);
+    }
+
+    close(pipeFds[1]);
+
+    // Message goes before dump, so the rest of big dump is read and dropped
+    size_t  outputSize = 0;
+    ssize_t readSize   = 0;
+    char    readBuffer[BUFSIZ];
+    while ((readSize = read(pipeFds[0], readBuffer, sizeof(readBuffer))) > 0) {
+        size_t copySize = CHECK_OUTPUT_SIZE - 1 - outputSize;
+        if (copySize > (size_t)readSize) copySize = (size_t)readSize;
+
+        memcpy(checkOutput + outputSize, readBuffer, copySize);
+        outputSize += copySize;
+    }
+    checkOutput[outputSize] = '\0';
+    close(pipeFds[0]);
+
+    int status = 0;
+    if (waitpid(child, &status, 0) != child) return false;
+
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV &&
+           strstr(checkOutput, CHECK_HIT_MESSAGE) != nullptr;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Registers guarded stacks and destroys them with StackDtor
+//!
+//! @return true if every register finds free entry
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool IsRegistryFreed(int32_t count) {
+    bool isOk = true;
+
+    for (uint32_t curStack = 0; curStack < 2 * GUARD_REGISTRY_SIZE; curStack++) {
+        Stack<T, Level> stack = {};
+        StackCtor_(&stack LOCATION (stack), DEFAULT_GROWTH_POLICY, Level, GUARD_ALLOCATOR);
+
+        isOk &= GuardStackRegister(&stack) == 0;
+
+        for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+            StackPush(&stack, (T)curIdx);
+        }
+
+        StackDtor(&stack);
+    }
+
+    return isOk;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+static void PrintCheckResult(const char* check, const char* type, int level, int32_t count,
+                             bool isOk) {
+    printf("%s,%s,%d,%d,%s\n", check, type, level, count, isOk ? "ok" : "failed");
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all checks for one element type on one level
+//!
+//! @return true if all checks passed
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool RunCheck(int32_t count) {
+    const char* type = StackElemInfo<T>::NAME;
+
+    bool overrun  = IsOverrunCaught<T, Level>(count);
+    PrintCheckResult("overrun",  type, Level, count, overrun);
+
+    bool registry = IsRegistryFreed<T, Level>(count / 64);
+    PrintCheckResult("registry", type, Level, count / 64, registry);
+
+    return overrun && registry;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all checks for one element type on every level
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool RunCheckLevels(int32_t count) {
+    bool isOk = RunCheck<T, LOW_LEVEL> (count);
+    isOk     &= RunCheck<T, MID_LEVEL> (count);
+    isOk     &= RunCheck<T, HIGH_LEVEL>(count);
+
+    return isOk;
+}
+
+int main(int argc, char* argv[]) {
+    int32_t count = CHECK_DEFAULT_COUNT;
+    if (argc > 1) count = atoi(argv[1]);
+
+    if (count <= 0) {
+        fprintf(stderr, "Usage: %s [count]\n", argv[0]);
+        return 1;
+    }
+
+    printf("check,type,level,count,result\n");
+
+    bool isOk = RunCheckLevels<int32_t>(count);
+    isOk     &= RunCheckLevels<double> (count);
+
+    return isOk ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+#include "stack_save.h"
+
+//-------------------------------------------------------------------------------------------
+//! Check of StackSave and StackLoad on every protection level
+//!
+//! @note Usage: stack_save_check [count]. Stack with count elements is saved to temporary
+//!       file and loaded back with fixed and dynamic level, then streams with flipped bit in
+//!       header or in the last chunk, cut stream and snapshot of other level must be
+//!       rejected. Output is CSV, one line per check:
+//!       check,type,level,count,result
+//-------------------------------------------------------------------------------------------
+
+const int32_t CHECK_DEFAULT_COUNT = 1 << 19;
+
+//-------------------------------------------------------------------------------------------
+//! Saves stack of count elements to new temporary file
+//!
+//! @return Stream at its beginning, nullptr if stack can't be saved
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+FILE* SaveCheckStream(int32_t count) {
+    Stack<T, Level> stack = {};
+    StackCtor_(&stack LOCATION (stack), DEFAULT_GROWTH_POLICY, Level);
+
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        StackPush(&stack, (T)curIdx);
+    }
+
+    FILE* stream = tmpfile();
+
+    bool isSaved = stream != nullptr && StackSave(&stack, stream) == 0;
+
+    StackDtor(&stack);
+
+    if (!isSaved) {
+        if (stream != nullptr) fclose(stream);
+        return nullptr;
+    }
+
+    rewind(stream);
+
+    return stream;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Loads stack and pops all its elements
+//!
+//! @return true if stack is loaded and keeps count pushed elements
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool IsLoadOk(FILE* stream, int32_t count) {
+    Stack<T, Level> stack = {};
+    if (StackLoad_(&stack, stream LOCATION (stack)) != NO_ERROR) return false;
+
+    bool isOk = stack.size == count;
+
+    for (int32_t curIdx = count - 1; isOk && curIdx >= 0; curIdx--) {
+        isOk &= StackPop(&stack) == (T)curIdx;
+    }
+
+    StackDtor(&stack);
+
+    return isOk;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Loads stack expecting error
+//!
+//! @return true if load returns expected error
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool IsLoadRejected(FILE* stream, int32_t expectedError) {
+    Stack<T, Level> stack = {};
+    int32_t error = StackLoad_(&stack, stream LOCATION (stack));
+
+    if (error == NO_ERROR) StackDtor(&stack);
+
+    return error == expectedError;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Flips one bit of stream and rewinds it
+//!
+//! @return true if stream is changed
+//-------------------------------------------------------------------------------------------
+
+static bool FlipCheckStreamBit(FILE* stream, long offset) {
+    int byte = EOF;
+    if (fseek(stream, offset, SEEK_SET) == 0) byte = fgetc(stream);
+
+    bool isFlipped = byte != EOF && fseek(stream, offset, SEEK_SET) == 0 &&
+                     fputc(byte ^ 0x10, stream) != EOF && fflush(stream) == 0;
+
+    rewind(stream);
+
+    return isFlipped;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Copies first size bytes of stream to new temporary file
+//!
+//! @return Stream at its beginning, nullptr if copy fails
+//-------------------------------------------------------------------------------------------
+
+static FILE* CutCheckStream(FILE* stream, long size) {
+    FILE* cutStream = tmpfile();
+    if (cutStream == nullptr) return nullptr;
+
+    for (long curByte = 0; curByte < size; curByte++) {
+        int byte = fgetc(stream);
+        if (byte == EOF || fputc(byte, cutStream) == EOF) break;
+    }
+
+    rewind(stream);
+    rewind(cutStream);
+
+    return cutStream;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Gets offset of the first data byte of the last chunk
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+long GetLastChunkOffset(int32_t count) {
+    uint64_t sizeOfData = (uint64_t)count * sizeof(T);
+    uint64_t lastChunk  = (sizeOfData - 1) / SAVE_CHUNK_SIZE;
+
+    return (long)(sizeof(StackSaveHeader) + lastChunk * (SAVE_CHUNK_SIZE + sizeof(hashValue)));
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+static void PrintCheckResult(const char* check, const char* type, int level, int32_t count,
+                             bool isOk) {
+    printf("%s,%s,%d,%d,%s\n", check, type, level, count, isOk ? "ok" : "failed");
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all checks for one element type on one level
+//!
+//! @return true if all checks passed
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+bool RunCheck(int32_t count) {
+    const char* type = StackElemInfo<T>::NAME;
+    const int   otherLevel = (Level == HIGH_LEVEL) ? LOW_LEVEL : HIGH_LEVEL;
+
+    FILE* stream = SaveCheckStream<T, Level>(count);
+    if (stream == nullptr) {
+        PrintCheckResult("save", type, Level, count, false);
+        return false;
+    }
+
+    bool fixed   = IsLoadOk<T, Level>(stream, count);
+    PrintCheckResult("fixed",   type, Level, count, fixed);
+
+    rewind(stream);
+    bool dynamic = IsLoadOk<T, DYNAMIC_LEVEL>(stream, count);
+    PrintCheckResult("dynamic", type, Level, count, dynamic);
+
+    rewind(stream);
+    bool level   = IsLoadRejected<T, otherLevel>(stream, FILE_INVALID);
+    PrintCheckResult("level",   type, Level, count, level);
+
+    rewind(stream);
+    FILE* cutStream = CutCheckStream(stream, GetLastChunkOffset<T>(count));
+    bool cut     = cutStream != nullptr && IsLoadRejected<T, Level>(cutStream, FILE_INVALID);
+    PrintCheckResult("cut",     type, Level, count, cut);
+    if (cutStream != nullptr) fclose(cutStream);
+
+    bool chunk   = FlipCheckStreamBit(stream, GetLastChunkOffset<T>(count)) &&
+                   IsLoadRejected<T, Level>(stream, DATA_HASH_IRRUPTION);
+    PrintCheckResult("chunk",   type, Level, count, chunk);
+
+    bool header  = FlipCheckStreamBit(stream, offsetof(StackSaveHeader, size)) &&
+                   IsLoadRejected<T, Level>(stream, FILE_INVALID);
+    PrintCheckResult("header",  type, Level, count, header);
+
+    fclose(stream);
+
+    return fixed && dynamic && level && cut && chunk && header;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all checks for one element type on every level
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool RunCheckLevels(int32_t count) {
+    bool isOk = RunCheck<T, LOW_LEVEL> (count);
+    isOk     &= RunCheck<T, MID_LEVEL> (count);
+    isOk     &= RunCheck<T, HIGH_LEVEL>(count);
+
+    return isOk;
+}
+
+int main(int argc, char* argv[]) {
+    int32_t count = CHECK_DEFAULT_COUNT;
+    if (argc > 1) count = atoi(argv[1]);
+
+    if (count <= 0) {
+        fprintf(stderr, "Usage: %s [count]\n", argv[0]);
+        return 1;
+    }
+
+    printf("check,type,level,count,result\n");
+
+    bool isOk = RunCheckLevels<int32_t>(count);
+    isOk     &= RunCheckLevels<double> (count);
+
+    return isOk ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+#include "stack_simd.h"
+
+//-------------------------------------------------------------------------------------------
+//! Comparison of every SIMD kernel set with scalar kernels
+//!
+//! @note Usage: stack_simd_check [seed]. Sets which CPU supports and the set which
+//!       GetSimdKernels chose (it follows STACK_SIMD environment variable) are run on random
+//!       data of many sizes, offsets and pattern sizes, results must be bit-exact. Output is
+//!       CSV, one line per set and kernel:
+//!       kernels,kernel,cases,mismatches
+//-------------------------------------------------------------------------------------------
+
+const uint64_t CHECK_DEFAULT_SEED    = 0x5EED;
+const uint64_t CHECK_MAX_SIZE        = 1 << 13;
+const uint64_t CHECK_MAX_OFFSET      = 64;
+const uint32_t CHECK_MAX_PATTERN     = 40;
+const uint64_t CHECK_MAX_COUNT       = 300;
+const uint32_t CHECK_SIZES_COUNT     = 400;
+const uint32_t CHECK_GUARD_SIZE      = 64;
+const uint8_t  CHECK_GUARD_BYTE      = 0xA5;
+
+static uint8_t checkSource[CHECK_MAX_SIZE + CHECK_MAX_OFFSET];
+static uint8_t checkExpected[CHECK_MAX_PATTERN * CHECK_MAX_COUNT + CHECK_MAX_OFFSET + CHECK_GUARD_SIZE];
+static uint8_t checkActual  [CHECK_MAX_PATTERN * CHECK_MAX_COUNT + CHECK_MAX_OFFSET + CHECK_GUARD_SIZE];
+
+//-------------------------------------------------------------------------------------------
+//! Counters of one kernel
+//-------------------------------------------------------------------------------------------
+
+struct CheckResult {
+    uint64_t cases;
+    uint64_t mismatches;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Gets random size in [0, maxSize), small sizes are more frequent
+//-------------------------------------------------------------------------------------------
+
+static uint64_t GetCheckSize(uint64_t* randomState, uint64_t maxSize) {
+    uint64_t limit = (GetRandom(randomState) % 2) ? 256 : maxSize;
+    if (limit > maxSize) limit = maxSize;
+
+    return GetRandom(randomState) % limit;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Compares getHash with scalar one on all offsets
+//-------------------------------------------------------------------------------------------
+
+static CheckResult CheckGetHash(const SimdKernels* kernels, uint64_t* randomState) {
+    CheckResult result = {};
+
+    for (uint32_t curSize = 0; curSize < CHECK_SIZES_COUNT; curSize++) {
+        uint64_t size = GetCheckSize(randomState, CHECK_MAX_SIZE);
+
+        for (uint64_t offset = 0; offset < CHECK_MAX_OFFSET; offset += 7) {
+            result.cases++;
+            result.mismatches += kernels->getHash(checkSource + offset, size) !=
+                                 GetHashScalar   (checkSource + offset, size);
+        }
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Compares getWordsHash with scalar one on random word ranges
+//-------------------------------------------------------------------------------------------
+
+static CheckResult CheckGetWordsHash(const SimdKernels* kernels, uint64_t* randomState) {
+    CheckResult result = {};
+
+    const uint64_t wordsCount = CHECK_MAX_SIZE / sizeof(uint64_t);
+
+    for (uint32_t curRange = 0; curRange < CHECK_SIZES_COUNT * 8; curRange++) {
+        uint64_t beginWord = GetRandom(randomState) % wordsCount;
+        uint64_t endWord   = beginWord + GetCheckSize(randomState, wordsCount - beginWord + 1);
+
+        result.cases++;
+        result.mismatches += kernels->getWordsHash(checkSource, beginWord, endWord) !=
+                             GetWordsHashScalar   (checkSource, beginWord, endWord);
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Compares fillPattern and isPatternFilled with scalar ones
+//!
+//! @note Bytes after filled part must stay untouched. isPatternFilled is checked on filled
+//!       memory and on memory with one changed byte
+//-------------------------------------------------------------------------------------------
+
+static void CheckPattern(const SimdKernels* kernels, uint64_t* randomState,
+                         CheckResult* fillResult, CheckResult* isFilledResult) {
+    for (uint32_t patternSize = 1; patternSize <= CHECK_MAX_PATTERN; patternSize++) {
+        for (uint32_t curCount = 0; curCount < CHECK_SIZES_COUNT / 8; curCount++) {
+            uint64_t count  = GetCheckSize(randomState, CHECK_MAX_COUNT);
+            uint64_t offset = GetRandom(randomState) % CHECK_MAX_OFFSET;
+            uint64_t size   = count * patternSize;
+
+            const uint8_t* pattern = checkSource + GetRandom(randomState) % CHECK_MAX_OFFSET;
+
+            memset(checkExpected, CHECK_GUARD_BYTE, offset + size + CHECK_GUARD_SIZE);
+            memset(checkActual,   CHECK_GUARD_BYTE, offset + size + CHECK_GUARD_SIZE);
+
+            FillPatternScalar   (checkExpected + offset, pattern, patternSize, count);
+            kernels->fillPattern(checkActual   + offset, pattern, patternSize, count);
+
+            fillResult->cases++;
+            fillResult->mismatches += memcmp(checkExpected, checkActual,
+                                             offset + size + CHECK_GUARD_SIZE) != 0;
+
+            isFilledResult->cases++;
+            isFilledResult->mismatches +=
+                kernels->isPatternFilled(checkExpected + offset, pattern, patternSize, count) !=
+                IsPatternFilledScalar   (checkExpected + offset, pattern, patternSize, count);
+
+            if (size == 0) continue;
+
+            checkExpected[offset + GetRandom(randomState) % size] ^= 1 << (GetRandom(randomState) % 8);
+
+            isFilledResult->cases++;
+            isFilledResult->mismatches +=
+                kernels->isPatternFilled(checkExpected + offset, pattern, patternSize, count) !=
+                IsPatternFilledScalar   (checkExpected + offset, pattern, patternSize, count);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+static void PrintCheckResult(const char* kernelsName, const char* kernel, CheckResult result) {
+    printf("%s,%s,%llu,%llu\n", kernelsName, kernel,
+           (unsigned long long)result.cases, (unsigned long long)result.mismatches);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs all comparisons for one kernel set
+//!
+//! @return true if there are no mismatches
+//-------------------------------------------------------------------------------------------
+
+static bool CheckKernels(const SimdKernels* kernels, uint64_t seed) {
+    uint64_t randomState = seed;
+
+    CheckResult getHash         = CheckGetHash     (kernels, &randomState);
+    CheckResult getWordsHash    = CheckGetWordsHash(kernels, &randomState);
+    CheckResult fillPattern     = {};
+    CheckResult isPatternFilled = {};
+    CheckPattern(kernels, &randomState, &fillPattern, &isPatternFilled);
+
+    PrintCheckResult(kernels->name, "getHash",         getHash);
+    PrintCheckResult(kernels->name, "getWordsHash",    getWordsHash);
+    PrintCheckResult(kernels->name, "fillPattern",     fillPattern);
+    PrintCheckResult(kernels->name, "isPatternFilled", isPatternFilled);
+
+    return getHash.mismatches == 0 && getWordsHash.mismatches == 0 &&
+           fillPattern.mismatches == 0 && isPatternFilled.mismatches == 0;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t seed = CHECK_DEFAULT_SEED;
+    if (argc > 1) seed = strtoull(argv[1], nullptr, 0) | 1;
+
+    uint64_t randomState = seed;
+    for (uint64_t curByte = 0; curByte < sizeof(checkSource); curByte++) {
+        checkSource[curByte] = (uint8_t)GetRandom(&randomState);
+    }
+
+    printf("kernels,kernel,cases,mismatches\n");
+
+    bool isOk = CheckKernels(GetSimdKernels(), seed);
+
+    #ifdef STACK_SIMD_X86
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("sse2")) {
+            const SimdKernels sse2 = { "sse2", GetHashSse2, GetWordsHashScalar,
+                                       FillPatternSse2, IsPatternFilledSse2 };
+            isOk &= CheckKernels(&sse2, seed);
+        }
+
+        if (__builtin_cpu_supports("avx2")) {
+            const SimdKernels avx2 = { "avx2", GetHashAvx2, GetWordsHashAvx2,
+                                       FillPatternAvx2, IsPatternFilledAvx2 };
+            isOk &= CheckKernels(&avx2, seed);
+        }
+    #endif
+
+    return isOk ? 0 : 1;
+}
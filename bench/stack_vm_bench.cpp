@@ -0,0 +1,189 @@
+#include "stack_vm.h"
+
+//-------------------------------------------------------------------------------------------
+//! Benchmark of stack machine against interpreter made of StackPush and StackPop calls
+//!
+//! @note Usage: stack_vm_bench [count]. Program runs count iterations of loop, output is
+//!       CSV, one line per runner: runner,type,level,count,ops,ns_per_op
+//-------------------------------------------------------------------------------------------
+
+const int32_t BENCH_DEFAULT_COUNT = 1 << 18;
+
+const int32_t BENCH_LOOP_BEGIN    = 1;
+const int32_t BENCH_LOOP_END      = 16;
+const int32_t BENCH_LOOP_SIZE     = 15;
+const int32_t BENCH_PROGRAM_SIZE  = 17;
+
+static volatile uint64_t benchSink = 0;
+
+//-------------------------------------------------------------------------------------------
+//! Result of one runner
+//-------------------------------------------------------------------------------------------
+
+struct BenchResult {
+    uint64_t ops;
+    uint64_t timeNs;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Makes program: counter goes from count down to 0, body computes (i * i + 7) / 3 and
+//! throws it away
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void GetBenchProgram(VmInstr<T>* code, int32_t count) {
+    VmInstr<T> program[BENCH_PROGRAM_SIZE] = {
+        { VM_PUSH, 0, (T)count },                                                 // i
+
+        { VM_DUP,  0, {} }, { VM_JZ, BENCH_LOOP_END, {} },                        // loop
+        { VM_DUP,  0, {} }, { VM_DUP,  0, {} }, { VM_MUL, 0, {} },                // i i*i
+        { VM_PUSH, 0, (T)7 }, { VM_ADD, 0, {} },                                  // i x
+        { VM_PUSH, 0, (T)3 }, { VM_DIV, 0, {} },                                  // i y
+        { VM_SWAP, 0, {} }, { VM_PUSH, 0, (T)1 }, { VM_SUB, 0, {} },              // y i-1
+        { VM_SWAP, 0, {} }, { VM_POP,  0, {} },                                   // i-1
+        { VM_JMP,  BENCH_LOOP_BEGIN, {} },
+
+        { VM_HALT, 0, {} }                                                        // end
+    };
+
+    memcpy(code, program, sizeof(program));
+}
+
+//-------------------------------------------------------------------------------------------
+//! Executes program with switch over opcodes and checked StackPush and StackPop calls
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+uint64_t RunCallsInterpreter(Stack<T, Level>* stack, const VmInstr<T>* code) {
+    uint64_t ops = 0;
+
+    for (int32_t curInstr = 0; ; curInstr++) {
+        const VmInstr<T>* instr = &code[curInstr];
+        ops++;
+
+        switch (instr->opcode) {
+            case VM_PUSH: StackPush(stack, instr->value); break;
+            case VM_POP:  StackPop(stack);                break;
+
+            case VM_ADD:  { T b = StackPop(stack); T a = StackPop(stack); StackPush(stack, a + b); break; }
+            case VM_SUB:  { T b = StackPop(stack); T a = StackPop(stack); StackPush(stack, a - b); break; }
+            case VM_MUL:  { T b = StackPop(stack); T a = StackPop(stack); StackPush(stack, a * b); break; }
+            case VM_DIV:  { T b = StackPop(stack); T a = StackPop(stack); StackPush(stack, a / b); break; }
+
+            case VM_DUP:  { T a = StackPop(stack); StackPush(stack, a); StackPush(stack, a); break; }
+            case VM_SWAP: { T b = StackPop(stack); T a = StackPop(stack); StackPush(stack, b); StackPush(stack, a); break; }
+
+            case VM_JMP:  curInstr = instr->target - 1; break;
+            case VM_JZ:   if (StackPop(stack) == (T)0) curInstr = instr->target - 1; break;
+            case VM_JNZ:  if (StackPop(stack) != (T)0) curInstr = instr->target - 1; break;
+
+            case VM_HALT:
+            case VM_BLOCK:
+            case VM_OPCODES_COUNT:
+            default:
+                return ops;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures program in interpreter of StackPush and StackPop calls
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchCalls(int32_t count) {
+    VmInstr<T> code[BENCH_PROGRAM_SIZE] = {};
+    GetBenchProgram(code, count);
+
+    StackCtorType(stack, T, Level);
+
+    uint64_t beginTime = GetTimeNs();
+    uint64_t ops       = RunCallsInterpreter(&stack, code);
+    uint64_t endTime   = GetTimeNs();
+
+    benchSink = benchSink + (uint64_t)StackPop(&stack);
+    StackDtor(&stack);
+
+    return { ops, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures program in VmRun
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+BenchResult BenchVm(int32_t count) {
+    VmInstr<T> code[BENCH_PROGRAM_SIZE] = {};
+    GetBenchProgram(code, count);
+
+    VmProgram<T> program = {};
+    VmProgramCtor(&program, code, BENCH_PROGRAM_SIZE);
+
+    StackCtorType(stack, T, Level);
+
+    uint64_t beginTime = GetTimeNs();
+    StackError error   = VmRun(&stack, &program);
+    uint64_t endTime   = GetTimeNs();
+
+    assert(error == NO_ERROR && "VM_ERR");
+    (void)error;
+
+    benchSink = benchSink + (uint64_t)StackPop(&stack);
+    StackDtor(&stack);
+    VmProgramDtor(&program);
+
+    // Same instructions as in interpreter: first push, loops, last check of counter and halt
+    return { (uint64_t)count * BENCH_LOOP_SIZE + 4, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+void PrintBenchResult(const char* runner, const char* type, int level, int32_t count,
+                      BenchResult result) {
+    printf("%s,%s,%d,%d,%llu,%.2lf\n", runner, type, level, count,
+           (unsigned long long)result.ops, (double)result.timeNs / (double)result.ops);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs both runners for one element type and level
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level>
+void RunBench(int32_t count) {
+    const char* type = StackElemInfo<T>::NAME;
+
+    PrintBenchResult("calls", type, Level, count, BenchCalls<T, Level>(count));
+    PrintBenchResult("vm",    type, Level, count, BenchVm   <T, Level>(count));
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs both runners for one element type on every level
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void RunBenchLevels(int32_t count) {
+    RunBench<T, LOW_LEVEL> (count);
+    RunBench<T, MID_LEVEL> (count);
+    RunBench<T, HIGH_LEVEL>(count);
+}
+
+int main(int argc, char* argv[]) {
+    int32_t count = BENCH_DEFAULT_COUNT;
+    if (argc > 1) count = atoi(argv[1]);
+
+    if (count <= 0) {
+        fprintf(stderr, "Usage: %s [count]\n", argv[0]);
+        return 1;
+    }
+
+    printf("runner,type,level,count,ops,ns_per_op\n");
+
+    RunBenchLevels<int64_t>(count);
+    RunBenchLevels<double> (count);
+
+    fprintf(stderr, "sink %llu\n", (unsigned long long)benchSink);
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <thread>
+
+#include "synchronized_stack.h"
+
+//-------------------------------------------------------------------------------------------
+//! Benchmark of synchronized stack under contention
+//!
+//! @note Usage: synchronized_stack_bench [threads] [count]. Every thread makes count pairs
+//!       of push and pop, output is CSV, one line per runner:
+//!       runner,type,threads,count,ops,ns_per_op
+//-------------------------------------------------------------------------------------------
+
+const int32_t BENCH_DEFAULT_THREADS = 16;
+const int32_t BENCH_DEFAULT_COUNT   = 1 << 15;
+const int32_t BENCH_MAX_THREADS     = 256;
+
+static std::atomic<uint64_t> benchSink = {};
+
+//-------------------------------------------------------------------------------------------
+//! Result of one runner
+//-------------------------------------------------------------------------------------------
+
+struct BenchResult {
+    uint64_t ops;
+    uint64_t timeNs;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Makes count pairs of push and pop with lock per operation
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void RunLockThread(SynchronizedStack<T>* stack, int32_t count) {
+    uint64_t sum = 0;
+
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        T poppedValue = {};
+
+        SynchronizedStackPush(stack, (T)curIdx);
+        if (SynchronizedStackPop(stack, &poppedValue) == NO_ERROR) sum += (uint64_t)poppedValue;
+    }
+
+    benchSink.fetch_add(sum, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Makes count pairs of push and pop with flat combining
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void RunCombiningThread(SynchronizedStack<T>* stack, int32_t count) {
+    uint64_t sum = 0;
+
+    for (int32_t curIdx = 0; curIdx < count; curIdx++) {
+        T poppedValue = {};
+
+        SynchronizedStackCombinePush(stack, (T)curIdx);
+        if (SynchronizedStackCombinePop(stack, &poppedValue) == NO_ERROR) sum += (uint64_t)poppedValue;
+    }
+
+    benchSink.fetch_add(sum, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures runner on threadsCount threads
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+BenchResult BenchThreads(void (*runner)(SynchronizedStack<T>*, int32_t),
+                         int32_t threadsCount, int32_t count) {
+    SynchronizedStackCtor(stack, T);
+
+    std::thread threads[BENCH_MAX_THREADS];
+
+    uint64_t beginTime = GetTimeNs();
+
+    for (int32_t curThread = 0; curThread < threadsCount; curThread++) {
+        threads[curThread] = std::thread(runner, &stack, count);
+    }
+
+    for (int32_t curThread = 0; curThread < threadsCount; curThread++) {
+        threads[curThread].join();
+    }
+
+    uint64_t endTime = GetTimeNs();
+
+    SynchronizedStackDtor(&stack);
+
+    return { (uint64_t)threadsCount * count * 2, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+void PrintBenchResult(const char* runner, const char* type, int32_t threadsCount, int32_t count,
+                      BenchResult result) {
+    printf("%s,%s,%d,%d,%llu,%.2lf\n", runner, type, threadsCount, count,
+           (unsigned long long)result.ops, (double)result.timeNs / (double)result.ops);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs both runners for one element type
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void RunBench(int32_t threadsCount, int32_t count) {
+    const char* type = StackElemInfo<T>::NAME;
+
+    PrintBenchResult("lock",      type, threadsCount, count,
+                     BenchThreads<T>(RunLockThread<T>,      threadsCount, count));
+    PrintBenchResult("combining", type, threadsCount, count,
+                     BenchThreads<T>(RunCombiningThread<T>, threadsCount, count));
+}
+
+int main(int argc, char* argv[]) {
+    int32_t threadsCount = BENCH_DEFAULT_THREADS;
+    int32_t count        = BENCH_DEFAULT_COUNT;
+
+    if (argc > 1) threadsCount = atoi(argv[1]);
+    if (argc > 2) count        = atoi(argv[2]);
+
+    if (threadsCount <= 0 || threadsCount > BENCH_MAX_THREADS || count <= 0) {
+        fprintf(stderr, "Usage: %s [threads] [count]\n", argv[0]);
+        return 1;
+    }
+
+    printf("runner,type,threads,count,ops,ns_per_op\n");
+
+    RunBench<int64_t>(threadsCount, count);
+    RunBench<double> (threadsCount, count);
+
+    fprintf(stderr, "sink %llu\n", (unsigned long long)benchSink.load());
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include <thread>
+
+#include "work_stealing_stack.h"
+
+//-------------------------------------------------------------------------------------------
+//! Benchmark of work stealing stack with one owner and several thieves
+//!
+//! @note Usage: work_stealing_stack_bench [thieves] [count]. Owner pushes count elements in
+//!       bursts and pops half of every burst, thieves steal until owner finishes. Then sum
+//!       of pushed elements is compared with sum of popped and stolen ones. Output is CSV:
+//!       runner,type,thieves,count,ops,ns_per_op
+//-------------------------------------------------------------------------------------------
+
+const int32_t BENCH_DEFAULT_THIEVES = 3;
+const int32_t BENCH_DEFAULT_COUNT   = 1 << 18;
+const int32_t BENCH_MAX_THIEVES     = 255;
+const int32_t BENCH_BURST_SIZE      = 256;
+
+static std::atomic<uint64_t> benchTakenSum   = {};
+static std::atomic<uint64_t> benchTakenCount = {};
+static std::atomic<bool>     benchIsOwnerDone = {};
+
+//-------------------------------------------------------------------------------------------
+//! Result of one runner
+//-------------------------------------------------------------------------------------------
+
+struct BenchResult {
+    uint64_t ops;
+    uint64_t timeNs;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Pushes count elements in bursts, pops half of every burst and the rest at the end
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void RunOwnerThread(WorkStealingStack<T>* stack, int32_t count) {
+    uint64_t takenSum   = 0;
+    uint64_t takenCount = 0;
+
+    for (int32_t burstBegin = 0; burstBegin < count; burstBegin += BENCH_BURST_SIZE) {
+        int32_t burstEnd = burstBegin + BENCH_BURST_SIZE;
+        if (burstEnd > count) burstEnd = count;
+
+        for (int32_t curIdx = burstBegin; curIdx < burstEnd; curIdx++) {
+            WorkStealingPush(stack, (T)curIdx);
+        }
+
+        for (int32_t curIdx = burstBegin; curIdx < burstEnd; curIdx += 2) {
+            T poppedValue = {};
+
+            if (WorkStealingPop(stack, &poppedValue) == NO_ERROR) {
+                takenSum += (uint64_t)poppedValue;
+                takenCount++;
+            }
+        }
+    }
+
+    T poppedValue = {};
+    while (WorkStealingPop(stack, &poppedValue) == NO_ERROR) {
+        takenSum += (uint64_t)poppedValue;
+        takenCount++;
+    }
+
+    benchTakenSum.fetch_add(takenSum, std::memory_order_relaxed);
+    benchTakenCount.fetch_add(takenCount, std::memory_order_relaxed);
+    benchIsOwnerDone.store(true, std::memory_order_release);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Steals elements until owner finishes
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void RunThiefThread(WorkStealingStack<T>* stack) {
+    uint64_t takenSum   = 0;
+    uint64_t takenCount = 0;
+
+    while (!benchIsOwnerDone.load(std::memory_order_acquire)) {
+        T stolenValue = {};
+
+        if (WorkStealingSteal(stack, &stolenValue) == NO_ERROR) {
+            takenSum += (uint64_t)stolenValue;
+            takenCount++;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    benchTakenSum.fetch_add(takenSum, std::memory_order_relaxed);
+    benchTakenCount.fetch_add(takenCount, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Measures owner with thievesCount thieves and checks that every element was taken once
+//!
+//! @return Result of runner, ops is 0 if sums don't match
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+BenchResult BenchThieves(int32_t thievesCount, int32_t count) {
+    WorkStealingCtor(stack, T);
+
+    benchTakenSum.store(0, std::memory_order_relaxed);
+    benchTakenCount.store(0, std::memory_order_relaxed);
+    benchIsOwnerDone.store(false, std::memory_order_relaxed);
+
+    std::thread thieves[BENCH_MAX_THIEVES];
+
+    uint64_t beginTime = GetTimeNs();
+
+    for (int32_t curThief = 0; curThief < thievesCount; curThief++) {
+        thieves[curThief] = std::thread(RunThiefThread<T>, &stack);
+    }
+
+    RunOwnerThread(&stack, count);
+
+    for (int32_t curThief = 0; curThief < thievesCount; curThief++) {
+        thieves[curThief].join();
+    }
+
+    uint64_t endTime = GetTimeNs();
+
+    WorkStealingDtor(&stack);
+
+    uint64_t pushedSum  = (uint64_t)count * (count - 1) / 2;
+    uint64_t takenSum   = benchTakenSum.load(std::memory_order_relaxed);
+    uint64_t takenCount = benchTakenCount.load(std::memory_order_relaxed);
+
+    if (takenSum != pushedSum || takenCount != (uint64_t)count) {
+        fprintf(stderr, "Sum check failed: pushed %llu in %d, taken %llu in %llu\n",
+                (unsigned long long)pushedSum, count,
+                (unsigned long long)takenSum, (unsigned long long)takenCount);
+
+        return { 0, endTime - beginTime };
+    }
+
+    return { (uint64_t)count * 2, endTime - beginTime };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Prints result as CSV line
+//-------------------------------------------------------------------------------------------
+
+void PrintBenchResult(const char* runner, const char* type, int32_t thievesCount, int32_t count,
+                      BenchResult result) {
+    printf("%s,%s,%d,%d,%llu,%.2lf\n", runner, type, thievesCount, count,
+           (unsigned long long)result.ops,
+           result.ops ? (double)result.timeNs / (double)result.ops : 0.0);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Runs bench for one element type
+//!
+//! @return true if sums match
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool RunBench(int32_t thievesCount, int32_t count) {
+    BenchResult result = BenchThieves<T>(thievesCount, count);
+    PrintBenchResult("stealing", StackElemInfo<T>::NAME, thievesCount, count, result);
+
+    return result.ops != 0;
+}
+
+int main(int argc, char* argv[]) {
+    int32_t thievesCount = BENCH_DEFAULT_THIEVES;
+    int32_t count        = BENCH_DEFAULT_COUNT;
+
+    if (argc > 1) thievesCount = atoi(argv[1]);
+    if (argc > 2) count        = atoi(argv[2]);
+
+    if (thievesCount < 0 || thievesCount > BENCH_MAX_THIEVES || count <= 0) {
+        fprintf(stderr, "Usage: %s [thieves] [count]\n", argv[0]);
+        return 1;
+    }
+
+    printf("runner,type,thieves,count,ops,ns_per_op\n");
+
+    bool isOk = RunBench<int64_t>(thievesCount, count);
+    isOk     &= RunBench<double> (thievesCount, count);
+
+    return isOk ? 0 : 1;
+}
@@ -0,0 +1,333 @@
+#ifndef _CONCURRENT_STACK_H_
+#define _CONCURRENT_STACK_H_
+
+#include <atomic>
+
+#include "stack.h"
+
+#define ConcurrentStackCtor(stack, type)           \
+    ConcurrentStack<type> stack = {};              \
+    ConcurrentStackCtor_(&stack LOCATION (stack));
+
+#define CheckConcurrentStack(stack)                                                           \
+    if (StackError error = IsConcurrentStackOk(stack)) {                                      \
+        printf("Error %s, read full description in dump file\n", ErrorToString(error));       \
+                                                                                              \
+        ConcurrentStackDump(stack LOCATION (stack));                                         \
+        assert(!"OK" && "Verify failed");                                                     \
+    }
+
+const uint32_t CONCURRENT_FIRST_CHUNK_SIZE = 64;
+const uint32_t CONCURRENT_CHUNKS_COUNT     = 26;
+
+const uint32_t FREE_LISTS_COUNT            = 16;
+
+const uint32_t ELIMINATION_SIZE            = 16;
+const uint32_t ELIMINATION_WAIT            = 256;
+const uint32_t BACKOFF_MAX_SPINS           = 1024;
+
+const uint64_t TAG_STEP                    = (uint64_t)1 << 32;
+const uint32_t INDEX_MASK                  = 0xFFFFFFFF;
+
+const uint32_t CONCURRENT_MAX_NODES       = INDEX_MASK - 1;
+
+enum EliminationSlotState {
+    SLOT_EMPTY   = 0,
+    SLOT_WRITING = 1,
+    SLOT_WAITING = 2,
+    SLOT_READING = 3,
+    SLOT_TAKEN   = 4,
+};
+
+//-------------------------------------------------------------------------------------------
+//! Node of concurrent stack, next is index of next node plus one (0 is end of list)
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct ConcurrentNode {
+    T value;
+    std::atomic<uint32_t> next;
+};
+
+//-------------------------------------------------------------------------------------------
+//! List of free nodes, top keeps node index plus one and ABA tag as top of stack
+//-------------------------------------------------------------------------------------------
+
+struct alignas(CACHE_LINE_SIZE) ConcurrentFreeList {
+    std::atomic<uint64_t> top;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Slot where pusher and popper meet and exchange value without touching top
+//!
+//! @note state is one of EliminationSlotState, value is written only by the pusher
+//!       which moved slot to SLOT_WRITING and read only by the popper which moved it
+//!       to SLOT_READING
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct alignas(CACHE_LINE_SIZE) EliminationSlot {
+    std::atomic<uint32_t> state;
+    T value;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Lock-free stack (Treiber stack) of T elements
+//!
+//! @note top and free list tops keep node index plus one in low 32 bits and ABA tag in high
+//!       32 bits. Nodes are never returned to the system before ConcurrentStackDtor, so
+//!       reading a node which was popped by other thread is safe. Chunk k contains
+//!       CONCURRENT_FIRST_CHUNK_SIZE * 2^k nodes, so node addresses are stable.
+//!       Free nodes are kept in FREE_LISTS_COUNT lists, every thread starts from its own
+//!       list, so threads don't fight for one free list top. size is approximate, it counts
+//!       elements which are being pushed, but it is never negative, so -1 marks destroyed stack.
+//!       T must be trivially copyable
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct ConcurrentStack {
+    typedef T Elem;
+
+    canary canaryLeft;
+
+    VarInfo creationInfo;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> top;
+    alignas(CACHE_LINE_SIZE) std::atomic<int32_t> size;
+    std::atomic<uint32_t> nodesCount;
+
+    ConcurrentFreeList freeLists[FREE_LISTS_COUNT];
+
+    std::atomic<ConcurrentNode<T>*> chunks[CONCURRENT_CHUNKS_COUNT];
+
+    EliminationSlot<T> eliminationArray[ELIMINATION_SIZE];
+
+    canary canaryRight;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Creates concurrent stack from ConcurrentStackCtor macro
+//!
+//! @param [in] stack Pointer to the stack structure which will be created
+//!
+//! @return 0 if no errors
+//!
+//! @note Constructor and destructor are not thread-safe
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t ConcurrentStackCtor_(ConcurrentStack<T>* stack, VarInfo creationInfo);
+
+//-------------------------------------------------------------------------------------------
+//! Destroys concurrent stack
+//!
+//! @param [in] stack Pointer to the stack which will be destroyed
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t ConcurrentStackDtor(ConcurrentStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Pushes element in concurrent stack
+//!
+//! @param [in] stack Pointer to the stack where element will be pushed
+//! @param [in] pushedValue Element which will be pushed
+//!
+//! @return 0 if no errors
+//!
+//! @note On contention pusher waits in elimination array for a popper and gives value
+//!       directly to it
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t ConcurrentStackPush(ConcurrentStack<T>* stack, typename ConcurrentStack<T>::Elem pushedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Pops element from concurrent stack
+//!
+//! @param [in]  stack Pointer to the stack where from element will be popped
+//! @param [out] poppedValue Pointer to the popped value
+//!
+//! @return 0 if element was popped, STACK_UNDERFLOW if stack was empty
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t ConcurrentStackPop(ConcurrentStack<T>* stack, T* poppedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Checks if concurrent stack is OK
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return One of StackError
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+StackError IsConcurrentStackOk(ConcurrentStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Writes full concurrent stack dump in outstream
+//!
+//! @param [in] stack Pointer to the stack which will be dumped
+//! @param [in] outstream Pointer to the stream where dump will be written (default is stdout)
+//!
+//! @return 0 if all OK
+//!
+//! @note Elements are listed only if no thread changes stack during dump
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int ConcurrentStackDump(ConcurrentStack<T>* stack, VarInfo dumpInfo, FILE* outstream = stdout);
+
+//-------------------------------------------------------------------------------------------
+//! Gets node by its index
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] nodeIdx Index of node (without plus one)
+//!
+//! @return Pointer to the node
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+ConcurrentNode<T>* GetConcurrentNode(ConcurrentStack<T>* stack, uint32_t nodeIdx);
+
+//-------------------------------------------------------------------------------------------
+//! Takes free node from free lists or from unused part of chunks
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return Index of node (without plus one)
+//!
+//! @note Every free list is tried once starting from list of current thread
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+uint32_t TakeConcurrentNode(ConcurrentStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Puts node in free list
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] nodeIdx Index of node (without plus one)
+//!
+//! @note Node goes to list of current thread, if CAS fails, next list is tried, after every
+//!       round over all lists thread backs off
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void ReleaseConcurrentNode(ConcurrentStack<T>* stack, uint32_t nodeIdx);
+
+//-------------------------------------------------------------------------------------------
+//! Pushes node index in tagged list
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] listTop Pointer to the tagged list top (top or free list top)
+//! @param [in] nodeIdx Index of node (without plus one)
+//! @param [in] tries Amount of CAS tries, 0 means until success
+//!
+//! @return true if node was pushed
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool PushConcurrentNode(ConcurrentStack<T>* stack, std::atomic<uint64_t>* listTop,
+                        uint32_t nodeIdx, uint32_t tries);
+
+//-------------------------------------------------------------------------------------------
+//! Pops node index from tagged list
+//!
+//! @param [in]  stack Pointer to the stack
+//! @param [in]  listTop Pointer to the tagged list top (top or free list top)
+//! @param [out] nodeIdx Pointer to the index of node plus one, 0 if list is empty
+//! @param [in]  tries Amount of CAS tries, 0 means until success
+//!
+//! @return false if all tries failed
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool PopConcurrentNode(ConcurrentStack<T>* stack, std::atomic<uint64_t>* listTop,
+                             uint32_t* nodeIdx, uint32_t tries);
+
+//-------------------------------------------------------------------------------------------
+//! Waits in random elimination slot for a popper
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] pushedValue Element which is pushed
+//!
+//! @return true if popper took value
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool TryEliminatePush(ConcurrentStack<T>* stack, const T& pushedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Takes value from random elimination slot if pusher waits there
+//!
+//! @param [in]  stack Pointer to the stack
+//! @param [out] poppedValue Pointer to the popped value
+//!
+//! @return true if value was taken
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool TryEliminatePop(ConcurrentStack<T>* stack, T* poppedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Spins some time to let other threads finish their operations
+//!
+//! @param [in] spins Amount of spins
+//-------------------------------------------------------------------------------------------
+
+inline void SpinWait(uint32_t spins) {
+    for (uint32_t curSpin = 0; curSpin < spins; curSpin++) {
+        #if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+        #endif
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//! Gets chunk which contains node
+//!
+//! @param [in] nodeIdx Index of node (without plus one)
+//!
+//! @return Index of chunk
+//-------------------------------------------------------------------------------------------
+
+inline uint32_t GetConcurrentChunk(uint32_t nodeIdx) {
+    return 63 - __builtin_clzll(nodeIdx / CONCURRENT_FIRST_CHUNK_SIZE + 1);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Gets pseudo-random value of current thread
+//!
+//! @return Pseudo-random value
+//-------------------------------------------------------------------------------------------
+
+inline uint64_t GetThreadRandom() {
+    static thread_local uint64_t randomState = 0;
+
+    if (randomState == 0)
+        randomState = (uint64_t)(uintptr_t)&randomState | 1;
+
+    return GetRandom(&randomState);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Gets free list slot of current thread
+//!
+//! @return Index of free list where thread starts to look for free node
+//-------------------------------------------------------------------------------------------
+
+inline uint32_t GetFreeListSlot() {
+    static std::atomic<uint32_t> nextSlot = {};
+    static thread_local uint32_t threadSlot =
+        nextSlot.fetch_add(1, std::memory_order_relaxed) % FREE_LISTS_COUNT;
+
+    return threadSlot;
+}
+
+#include "concurrent_stack_impl.h"
+
+#endif
@@ -0,0 +1,333 @@
+#ifndef _CONCURRENT_STACK_IMPL_H_
+#define _CONCURRENT_STACK_IMPL_H_
+
+template <typename T>
+int32_t ConcurrentStackCtor_(ConcurrentStack<T>* stack, VarInfo creationInfo) {
+    assert(stack != nullptr && "STACK_NULL");
+
+    stack->canaryLeft   = CANARY;
+    stack->canaryRight  = CANARY;
+
+    stack->creationInfo = creationInfo;
+
+    stack->top.store(0, std::memory_order_relaxed);
+    stack->size.store(0, std::memory_order_relaxed);
+    stack->nodesCount.store(0, std::memory_order_relaxed);
+
+    for (uint32_t curList = 0; curList < FREE_LISTS_COUNT; curList++) {
+        stack->freeLists[curList].top.store(0, std::memory_order_relaxed);
+    }
+
+    for (uint32_t curChunk = 0; curChunk < CONCURRENT_CHUNKS_COUNT; curChunk++) {
+        stack->chunks[curChunk].store(nullptr, std::memory_order_relaxed);
+    }
+
+    for (uint32_t curSlot = 0; curSlot < ELIMINATION_SIZE; curSlot++) {
+        stack->eliminationArray[curSlot].state.store(SLOT_EMPTY, std::memory_order_relaxed);
+    }
+
+    return 0;
+}
+
+template <typename T>
+int32_t ConcurrentStackDtor(ConcurrentStack<T>* stack) {
+    CheckConcurrentStack(stack);
+
+    for (uint32_t curChunk = 0; curChunk < CONCURRENT_CHUNKS_COUNT; curChunk++) {
+        free(stack->chunks[curChunk].load(std::memory_order_acquire));
+        stack->chunks[curChunk].store(nullptr, std::memory_order_relaxed);
+    }
+
+    stack->top.store(0, std::memory_order_relaxed);
+    stack->nodesCount.store(0, std::memory_order_relaxed);
+    stack->size.store(-1, std::memory_order_relaxed);
+
+    for (uint32_t curList = 0; curList < FREE_LISTS_COUNT; curList++) {
+        stack->freeLists[curList].top.store(0, std::memory_order_relaxed);
+    }
+
+    return 0;
+}
+
+template <typename T>
+int32_t ConcurrentStackPush(ConcurrentStack<T>* stack, typename ConcurrentStack<T>::Elem pushedValue) {
+    CheckConcurrentStack(stack);
+
+    uint32_t nodeIdx = TakeConcurrentNode(stack);
+    GetConcurrentNode(stack, nodeIdx)->value = pushedValue;
+
+    // Size grows before node is published, so popper of this node can't make it negative
+    stack->size.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t spins = 1;
+    while (!PushConcurrentNode(stack, &stack->top, nodeIdx, 1)) {
+        if (TryEliminatePush(stack, pushedValue)) {
+            stack->size.fetch_sub(1, std::memory_order_relaxed);
+            ReleaseConcurrentNode(stack, nodeIdx);
+
+            return 0;
+        }
+
+        SpinWait(spins);
+        if (spins < BACKOFF_MAX_SPINS) spins *= 2;
+    }
+
+    return 0;
+}
+
+template <typename T>
+int32_t ConcurrentStackPop(ConcurrentStack<T>* stack, T* poppedValue) {
+    CheckConcurrentStack(stack);
+    assert(poppedValue != nullptr && "VALUE_NULL");
+
+    uint32_t nodeIdx = 0;
+
+    uint32_t spins = 1;
+    while (!PopConcurrentNode(stack, &stack->top, &nodeIdx, 1)) {
+        if (TryEliminatePop(stack, poppedValue)) return 0;
+
+        SpinWait(spins);
+        if (spins < BACKOFF_MAX_SPINS) spins *= 2;
+    }
+
+    if (nodeIdx == 0) return STACK_UNDERFLOW;
+
+    *poppedValue = GetConcurrentNode(stack, nodeIdx - 1)->value;
+    stack->size.fetch_sub(1, std::memory_order_relaxed);
+
+    ReleaseConcurrentNode(stack, nodeIdx - 1);
+
+    return 0;
+}
+
+template <typename T>
+StackError IsConcurrentStackOk(ConcurrentStack<T>* stack) {
+    if (stack == nullptr)              return STACK_NULL;
+    if (stack->canaryLeft  != CANARY)  return LEFT_STACK_CANARY_IRRUPTION;
+    if (stack->canaryRight != CANARY)  return RIGHT_STACK_CANARY_IRRUPTION;
+    if (stack->size.load(std::memory_order_relaxed) == -1)
+                                       return STACK_FREE;
+
+    return NO_ERROR;
+}
+
+template <typename T>
+int ConcurrentStackDump(ConcurrentStack<T>* stack, VarInfo dumpInfo, FILE* outstream) {
+    DumpBuffer buffer = {};
+    DumpBufferCtor(&buffer);
+
+    DumpPrintf(&buffer, "Dump from %s() at %s(%d) in stack called now \"%s\": IsConcurrentStackOk() %s\n",
+               dumpInfo.function, dumpInfo.file, dumpInfo.line, dumpInfo.name,
+               ErrorToString(IsConcurrentStackOk(stack)));
+
+    if (stack == nullptr) return DumpFinish(&buffer, outstream);
+
+    DumpPrintf(&buffer, "concurrent stack <%s> [%p] \"%s\" ",
+               StackElemInfo<T>::NAME, stack, stack->creationInfo.name);
+    DumpPrintf(&buffer, "from %s (%d), %s(): {\n",
+               stack->creationInfo.file,  stack->creationInfo.line, stack->creationInfo.function);
+
+    uint64_t top     = stack->top.load(std::memory_order_acquire);
+    uint32_t nodesCount = stack->nodesCount.load(std::memory_order_acquire);
+
+    DumpPrintf(&buffer, "size     = %d\n", stack->size.load(std::memory_order_relaxed));
+    DumpPrintf(&buffer, "nodes    = %u\n", nodesCount);
+    DumpPrintf(&buffer, "top      = %u (tag %u)\n\n",
+               (uint32_t)(top & INDEX_MASK),     (uint32_t)(top >> 32));
+
+    DumpPrintf(&buffer, "Free lists:\n");
+    for (uint32_t curList = 0; curList < FREE_LISTS_COUNT; curList++) {
+        uint64_t freeTop = stack->freeLists[curList].top.load(std::memory_order_acquire);
+
+        if ((freeTop & INDEX_MASK) != 0)
+            DumpPrintf(&buffer, "    [%u] top = %u (tag %u)\n", curList,
+                       (uint32_t)(freeTop & INDEX_MASK), (uint32_t)(freeTop >> 32));
+    }
+    DumpPrintf(&buffer, "\n");
+
+    DumpPrintf(&buffer, "Stack canaries:\n");
+    DumpPrintf(&buffer, "    canaryLeft[%p] = %ud (%s)\n",
+               &stack->canaryLeft,  stack->canaryLeft,  (stack->canaryLeft  == CANARY) ?
+               "Ok" : "IRRUPTION");
+    DumpPrintf(&buffer, "    canaryRight[%p] = %ud (%s)\n\n",
+               &stack->canaryRight, stack->canaryRight, (stack->canaryRight == CANARY) ?
+               "Ok" : "IRRUPTION");
+
+    DumpPrintf(&buffer, "Elimination slots:\n");
+    for (uint32_t curSlot = 0; curSlot < ELIMINATION_SIZE; curSlot++) {
+        uint32_t slotState = stack->eliminationArray[curSlot].state.load(std::memory_order_relaxed);
+
+        if (slotState != SLOT_EMPTY)
+            DumpPrintf(&buffer, "    [%u] state = %u\n", curSlot, slotState);
+    }
+
+    DumpPrintf(&buffer, "\nnodes from top\n{\n");
+
+    uint32_t curNode = (uint32_t)(top & INDEX_MASK);
+    for (int32_t curIdx = 0; curNode != 0; curIdx++) {
+        if (curNode > nodesCount || (uint32_t)curIdx >= nodesCount) {
+            DumpPrintf(&buffer, "   [%d] node %u (BROKEN LINK)\n", curIdx, curNode);
+            break;
+        }
+
+        ConcurrentNode<T>* node = GetConcurrentNode(stack, curNode - 1);
+
+        DumpPrintf(&buffer, "   *[%d][%p] node %u = ", curIdx, node, curNode);
+        StackElemInfo<T>::Print(&buffer, node->value);
+        DumpPrintf(&buffer, "\n");
+
+        curNode = node->next.load(std::memory_order_relaxed);
+    }
+
+    DumpPrintf(&buffer, "}\n");
+
+    return DumpFinish(&buffer, outstream);
+}
+
+template <typename T>
+ConcurrentNode<T>* GetConcurrentNode(ConcurrentStack<T>* stack, uint32_t nodeIdx) {
+    uint32_t chunkIdx   = GetConcurrentChunk(nodeIdx);
+    uint32_t chunkBegin = CONCURRENT_FIRST_CHUNK_SIZE * ((1u << chunkIdx) - 1);
+
+    return stack->chunks[chunkIdx].load(std::memory_order_acquire) + (nodeIdx - chunkBegin);
+}
+
+template <typename T>
+uint32_t TakeConcurrentNode(ConcurrentStack<T>* stack) {
+    uint32_t nodeIdx = 0;
+    uint32_t slot    = GetFreeListSlot();
+
+    for (uint32_t curList = 0; curList < FREE_LISTS_COUNT; curList++) {
+        std::atomic<uint64_t>* freeTop = &stack->freeLists[(slot + curList) % FREE_LISTS_COUNT].top;
+
+        if ((freeTop->load(std::memory_order_relaxed) & INDEX_MASK) != 0 &&
+            PopConcurrentNode(stack, freeTop, &nodeIdx, 1) && nodeIdx != 0)
+            return nodeIdx - 1;
+    }
+
+    nodeIdx = stack->nodesCount.fetch_add(1, std::memory_order_relaxed);
+    assert(nodeIdx < CONCURRENT_MAX_NODES && "STACK_OVERFLOW");
+
+    uint32_t chunkIdx = GetConcurrentChunk(nodeIdx);
+    std::atomic<ConcurrentNode<T>*>* chunk = &stack->chunks[chunkIdx];
+
+    if (chunk->load(std::memory_order_acquire) == nullptr) {
+        ConcurrentNode<T>* newChunk = (ConcurrentNode<T>*)calloc((size_t)CONCURRENT_FIRST_CHUNK_SIZE << chunkIdx,
+                                                                 sizeof(ConcurrentNode<T>));
+        assert(newChunk != nullptr && "DATA_NULL");
+
+        ConcurrentNode<T>* emptyChunk = nullptr;
+        if (!chunk->compare_exchange_strong(emptyChunk, newChunk, std::memory_order_acq_rel))
+            free(newChunk);
+    }
+
+    return nodeIdx;
+}
+
+template <typename T>
+void ReleaseConcurrentNode(ConcurrentStack<T>* stack, uint32_t nodeIdx) {
+    uint32_t slot  = GetFreeListSlot();
+    uint32_t spins = 1;
+
+    for (uint32_t curList = slot; ; curList++) {
+        if (PushConcurrentNode(stack, &stack->freeLists[curList % FREE_LISTS_COUNT].top, nodeIdx, 1))
+            return;
+
+        if ((curList + 1) % FREE_LISTS_COUNT == slot) {
+            SpinWait(spins);
+            if (spins < BACKOFF_MAX_SPINS) spins *= 2;
+        }
+    }
+}
+
+template <typename T>
+bool PushConcurrentNode(ConcurrentStack<T>* stack, std::atomic<uint64_t>* listTop,
+                        uint32_t nodeIdx, uint32_t tries) {
+    ConcurrentNode<T>* node = GetConcurrentNode(stack, nodeIdx);
+    uint64_t oldTop = listTop->load(std::memory_order_relaxed);
+
+    for (uint32_t curTry = 0; tries == 0 || curTry < tries; curTry++) {
+        node->next.store((uint32_t)(oldTop & INDEX_MASK), std::memory_order_relaxed);
+
+        uint64_t newTop = ((oldTop & ~(uint64_t)INDEX_MASK) + TAG_STEP) | (nodeIdx + 1);
+        if (listTop->compare_exchange_weak(oldTop, newTop,
+                                           std::memory_order_release, std::memory_order_relaxed))
+            return true;
+    }
+
+    return false;
+}
+
+template <typename T>
+bool PopConcurrentNode(ConcurrentStack<T>* stack, std::atomic<uint64_t>* listTop,
+                       uint32_t* nodeIdx, uint32_t tries) {
+    uint64_t oldTop = listTop->load(std::memory_order_acquire);
+
+    for (uint32_t curTry = 0; tries == 0 || curTry < tries; curTry++) {
+        uint32_t topIdx = (uint32_t)(oldTop & INDEX_MASK);
+        if (topIdx == 0) {
+            *nodeIdx = 0;
+            return true;
+        }
+
+        uint32_t nextIdx = GetConcurrentNode(stack, topIdx - 1)->next.load(std::memory_order_relaxed);
+
+        uint64_t newTop = ((oldTop & ~(uint64_t)INDEX_MASK) + TAG_STEP) | nextIdx;
+        if (listTop->compare_exchange_weak(oldTop, newTop,
+                                           std::memory_order_acquire, std::memory_order_acquire)) {
+            *nodeIdx = topIdx;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+bool TryEliminatePush(ConcurrentStack<T>* stack, const T& pushedValue) {
+    EliminationSlot<T>* slot = &stack->eliminationArray[GetThreadRandom() % ELIMINATION_SIZE];
+
+    uint32_t slotState = SLOT_EMPTY;
+    if (!slot->state.compare_exchange_strong(slotState, SLOT_WRITING, std::memory_order_acquire))
+        return false;
+
+    slot->value = pushedValue;
+    slot->state.store(SLOT_WAITING, std::memory_order_release);
+
+    for (uint32_t curWait = 0; curWait < ELIMINATION_WAIT; curWait++) {
+        if (slot->state.load(std::memory_order_acquire) == SLOT_TAKEN) {
+            slot->state.store(SLOT_EMPTY, std::memory_order_release);
+            return true;
+        }
+
+        SpinWait(1);
+    }
+
+    slotState = SLOT_WAITING;
+    if (slot->state.compare_exchange_strong(slotState, SLOT_EMPTY, std::memory_order_acq_rel))
+        return false;
+
+    while (slot->state.load(std::memory_order_acquire) != SLOT_TAKEN) {
+        SpinWait(1);
+    }
+
+    slot->state.store(SLOT_EMPTY, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+bool TryEliminatePop(ConcurrentStack<T>* stack, T* poppedValue) {
+    EliminationSlot<T>* slot = &stack->eliminationArray[GetThreadRandom() % ELIMINATION_SIZE];
+
+    uint32_t slotState = SLOT_WAITING;
+    if (!slot->state.compare_exchange_strong(slotState, SLOT_READING, std::memory_order_acquire))
+        return false;
+
+    *poppedValue = slot->value;
+    slot->state.store(SLOT_TAKEN, std::memory_order_release);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef _SEGMENTED_STACK_H_
+#define _SEGMENTED_STACK_H_
+
+#include "stack.h"
+
+#define SegmentedStackCtor(stack, type)            \
+    SegmentedStack<type> stack = {};               \
+    SegmentedStackCtor_(&stack LOCATION (stack));
+
+#define SegmentedStackCtorAlloc(stack, type, allocator)                   \
+    SegmentedStack<type> stack = {};                                      \
+    SegmentedStackCtor_(&stack LOCATION (stack), allocator);
+
+#define SegmentedStackCtorType(stack, type, level) \
+    SegmentedStack<type, level> stack = {};        \
+    SegmentedStackCtor_(&stack LOCATION (stack));
+
+#define SegmentedStackCtorLevel(stack, type, level)                       \
+    SegmentedStack<type, DYNAMIC_LEVEL> stack = {};                       \
+    SegmentedStackCtor_(&stack LOCATION (stack), MALLOC_ALLOCATOR, level);
+
+#define SEGMENTED_TEMPLATE template <typename T, int Level>
+#define SEGMENTED_TYPE     SegmentedStack<T, Level>
+
+const size_t  SEGMENT_CHUNK_BYTES                  = 1 << 14;
+const int64_t SEGMENT_DIRECTORY_BEGINNING_CAPACITY = 16;
+
+//-------------------------------------------------------------------------------------------
+//! Fixed-size chunk of segmented stack
+//!
+//! @note dataHash is sum of word hashes of whole data, free cells are poisoned, so hash is
+//!       updated only for the written element
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct SegmentChunk {
+    static constexpr int64_t CAPACITY = (sizeof(T) < SEGMENT_CHUNK_BYTES) ?
+                                        SEGMENT_CHUNK_BYTES / sizeof(T) : 1;
+
+    canary canaryLeft;
+    hashValue dataHash;
+
+    T data[CAPACITY];
+
+    canary canaryRight;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Stack of T elements stored in chunks which never move
+//!
+//! @note Element i lives in chunks[i / CAPACITY]->data[i % CAPACITY], so pointer to element
+//!       stays valid until the element is popped. Growing adds a chunk and reallocates only
+//!       the directory of chunk pointers. One free chunk is kept above the top, the next
+//!       one is released, so push and pop at chunk border don't allocate every time
+//!       Level is protection level as in Stack, DYNAMIC_LEVEL stack gets it in constructor.
+//!       checkedBorder is the last chunk border where chunk below it was fully checked
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level = STACK_DEBUG>
+struct SegmentedStack {
+    typedef T Elem;
+
+    canary canaryLeft;
+
+    int32_t level;
+
+    VarInfo creationInfo;
+
+    int64_t size;
+    int64_t checkedBorder;
+
+    SegmentChunk<T>** chunks;
+    int64_t chunksCount;
+    int64_t directoryCapacity;
+
+    StackAllocator allocator;
+
+    canary canaryRight;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Creates segmented stack from SegmentedStackCtor macro
+//!
+//! @param [in] stack Pointer to the stack structure which will be created
+//! @param [in] allocator Allocator of chunks and directory
+//! @param [in] level Protection level, must be equal to Level if it isn't DYNAMIC_LEVEL
+//!
+//! @return 0 if no errors
+//!
+//! @note Chunks aren't allocated until the first push
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackCtor_(SEGMENTED_TYPE* stack, VarInfo creationInfo,
+                            StackAllocator allocator = MALLOC_ALLOCATOR,
+                            int level = (Level == DYNAMIC_LEVEL) ? STACK_DEBUG : Level);
+
+//-------------------------------------------------------------------------------------------
+//! Destroys segmented stack and all its chunks
+//!
+//! @param [in] stack Pointer to the stack which will be destroyed
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackDtor(SEGMENTED_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Pushes element at the top
+//!
+//! @param [in] stack Pointer to the stack where element will be pushed
+//! @param [in] pushedValue Element which will be pushed
+//!
+//! @return 0 if no errors
+//!
+//! @note Elements are never copied, push costs at most one chunk allocation and, rarely,
+//!       reallocation of directory. At HIGH_LEVEL hash and poison of chunk are checked when
+//!       top leaves it (SegmentedStackCheckBorder)
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackPush(SEGMENTED_TYPE* stack, typename SEGMENTED_TYPE::Elem pushedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Pops element from the top
+//!
+//! @param [in] stack Pointer to the stack where from element will be popped
+//!
+//! @return Popped element
+//!
+//! @note At HIGH_LEVEL chunk below is checked with hash and poison when top comes in it
+//!       (SegmentedStackCheckBorder)
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+T SegmentedStackPop(SEGMENTED_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Checks chunk below the top with hash and poison if top is at new chunk border
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @note Chunk takes O(chunk size) to check, push and pop at one border check it once, so
+//!       amortized check cost of push and pop doesn't depend on chunk size
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+void SegmentedStackCheckBorder(SEGMENTED_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Gets element by its index
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] elemIdx Index of element, 0 is the bottom
+//!
+//! @return Pointer to the element, it is valid until the element is popped
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+T* GetSegmentedElem(SEGMENTED_TYPE* stack, int64_t elemIdx);
+
+//-------------------------------------------------------------------------------------------
+//! Allocates poisoned chunk with canaries and hash and adds it to the directory
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackAddChunk(SEGMENTED_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Releases the last chunk if there are two free chunks above the top
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackReleaseChunk(SEGMENTED_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Writes element in chunk and updates chunk hash by words of this element
+//!
+//! @param [in] chunk Pointer to the chunk
+//! @param [in] elemIdx Index of element in chunk
+//! @param [in] value Written value
+//! @param [in] level Protection level of stack, hash is kept only at HIGH_LEVEL
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void SegmentChunkWrite(SegmentChunk<T>* chunk, int64_t elemIdx, T value, int level);
+
+//-------------------------------------------------------------------------------------------
+//! Gets hash of whole chunk data
+//!
+//! @param [in] chunk Pointer to the chunk
+//!
+//! @return Calculated hash
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+hashValue GetSegmentChunkHash(SegmentChunk<T>* chunk);
+
+//-------------------------------------------------------------------------------------------
+//! Checks canaries of chunk and, if level >= HIGH_LEVEL, its hash and poison
+//!
+//! @param [in] chunk Pointer to the chunk
+//! @param [in] usedCount Amount of elements in chunk, the rest must be poisoned
+//! @param [in] level Protection level of stack
+//!
+//! @return One of StackError
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+StackError IsSegmentChunkOk(SegmentChunk<T>* chunk, int64_t usedCount, int level);
+
+//-------------------------------------------------------------------------------------------
+//! Checks stack structure and canaries of the chunk with top element
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return One of StackError
+//!
+//! @note Cost doesn't depend on size and chunk size, it is checked in push and pop if
+//!       level >= MID_LEVEL
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+StackError IsTopChunkOk(SEGMENTED_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Checks stack structure and the chunk with top element with its hash and poison
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return One of StackError
+//!
+//! @note Takes O(chunk size), push and pop call it at HIGH_LEVEL only when top crosses
+//!       chunk border (SegmentedStackCheckBorder)
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+StackError IsTopChunkFullOk(SEGMENTED_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Gets protection level of segmented stack
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return Level template parameter or level field for DYNAMIC_LEVEL stack
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+inline int SegmentedStackLevel(const SEGMENTED_TYPE* stack) {
+    return (Level == DYNAMIC_LEVEL) ? stack->level : Level;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Checks segmented stack and all its chunks as IsAllOk checks Stack
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return One of StackError
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+StackError IsAllOk(SEGMENTED_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Writes full segmented stack dump in outstream
+//!
+//! @param [in] stack Pointer to the stack which will be dumped
+//! @param [in] outstream Pointer to the stream where dump will be written (default is stdout)
+//!
+//! @return 0 if all OK
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+int StackDump(SEGMENTED_TYPE* stack, VarInfo dumpInfo, FILE* outstream = stdout);
+
+#include "segmented_stack_impl.h"
+
+#endif
@@ -0,0 +1,372 @@
+#ifndef _SEGMENTED_STACK_IMPL_H_
+#define _SEGMENTED_STACK_IMPL_H_
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackCtor_(SEGMENTED_TYPE* stack, VarInfo creationInfo, StackAllocator allocator,
+                            int level) {
+    assert(stack != nullptr && "STACK_NULL");
+
+    assert(level >= LOW_LEVEL && level <= HIGH_LEVEL          && "LEVEL_INVALID");
+    assert((Level == DYNAMIC_LEVEL || level == Level)         && "LEVEL_INVALID");
+
+    stack->level        = level;
+
+    stack->canaryLeft   = CANARY;
+    stack->canaryRight  = CANARY;
+
+    stack->creationInfo = creationInfo;
+    stack->allocator    = allocator;
+
+    stack->size              = 0;
+    stack->checkedBorder     = -1;
+    stack->chunksCount       = 0;
+    stack->directoryCapacity = SEGMENT_DIRECTORY_BEGINNING_CAPACITY;
+
+    stack->chunks = (SegmentChunk<T>**)allocator.allocate(allocator.context,
+                                                          stack->directoryCapacity * sizeof(SegmentChunk<T>*));
+    assert(stack->chunks != nullptr && "DATA_NULL");
+
+    return 0;
+}
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackDtor(SEGMENTED_TYPE* stack) {
+    CheckStack(stack, IsAllOk);
+
+    for (int64_t curChunk = 0; curChunk < stack->chunksCount; curChunk++) {
+        stack->allocator.deallocate(stack->allocator.context, stack->chunks[curChunk],
+                                    sizeof(SegmentChunk<T>));
+    }
+
+    stack->allocator.deallocate(stack->allocator.context, stack->chunks,
+                                stack->directoryCapacity * sizeof(SegmentChunk<T>*));
+
+    stack->chunks      = nullptr;
+    stack->chunksCount = 0;
+    stack->size        = -1;
+
+    return 0;
+}
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackPush(SEGMENTED_TYPE* stack, typename SEGMENTED_TYPE::Elem pushedValue) {
+    int level = SegmentedStackLevel(stack);
+
+    if (level >= MID_LEVEL)
+        CheckStack(stack, IsTopChunkOk);
+
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+
+    if (level >= HIGH_LEVEL)
+        SegmentedStackCheckBorder(stack);
+
+    if (stack->size == stack->chunksCount * capacity)
+        SegmentedStackAddChunk(stack);
+
+    SegmentChunkWrite(stack->chunks[stack->size / capacity], stack->size % capacity, pushedValue, level);
+    stack->size++;
+
+    if (level >= MID_LEVEL)
+        CheckStack(stack, IsTopChunkOk);
+
+    return 0;
+}
+
+SEGMENTED_TEMPLATE
+T SegmentedStackPop(SEGMENTED_TYPE* stack) {
+    int level = SegmentedStackLevel(stack);
+
+    if (level >= MID_LEVEL)
+        CheckStack(stack, IsTopChunkOk);
+
+    assert(stack->size != 0 && "STACK_UNDERFLOW");
+
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+
+    stack->size--;
+
+    SegmentChunk<T>* chunk = stack->chunks[stack->size / capacity];
+    T poppedValue = chunk->data[stack->size % capacity];
+
+    SegmentChunkWrite(chunk, stack->size % capacity, StackElemInfo<T>::Poison(), level);
+
+    SegmentedStackReleaseChunk(stack);
+
+    if (level >= MID_LEVEL)
+        CheckStack(stack, IsTopChunkOk);
+
+    if (level >= HIGH_LEVEL)
+        SegmentedStackCheckBorder(stack);
+
+    return poppedValue;
+}
+
+SEGMENTED_TEMPLATE
+void SegmentedStackCheckBorder(SEGMENTED_TYPE* stack) {
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+
+    if (stack->size % capacity != 0 || stack->size / capacity == stack->checkedBorder) return;
+
+    CheckStack(stack, IsTopChunkFullOk);
+    stack->checkedBorder = stack->size / capacity;
+}
+
+SEGMENTED_TEMPLATE
+T* GetSegmentedElem(SEGMENTED_TYPE* stack, int64_t elemIdx) {
+    assert(stack != nullptr && "STACK_NULL");
+    assert(elemIdx >= 0 && elemIdx < stack->size && "INDEX_INVALID");
+
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+
+    return &stack->chunks[elemIdx / capacity]->data[elemIdx % capacity];
+}
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackAddChunk(SEGMENTED_TYPE* stack) {
+    if (stack->chunksCount == stack->directoryCapacity) {
+        int64_t newCapacity = 2 * stack->directoryCapacity;
+
+        stack->chunks = (SegmentChunk<T>**)stack->allocator.reallocate(stack->allocator.context, stack->chunks,
+                                                                       stack->directoryCapacity * sizeof(SegmentChunk<T>*),
+                                                                       newCapacity              * sizeof(SegmentChunk<T>*));
+        assert(stack->chunks != nullptr && "MEMORY_RESIZE_ERR");
+
+        stack->directoryCapacity = newCapacity;
+    }
+
+    SegmentChunk<T>* chunk = (SegmentChunk<T>*)stack->allocator.allocate(stack->allocator.context,
+                                                                         sizeof(SegmentChunk<T>));
+    assert(chunk != nullptr && "DATA_NULL");
+
+    chunk->canaryLeft  = CANARY;
+    chunk->canaryRight = CANARY;
+
+    T poison = StackElemInfo<T>::Poison();
+    FillPattern((uint8_t*)chunk->data, &poison, sizeof(T), SegmentChunk<T>::CAPACITY);
+
+    if (SegmentedStackLevel(stack) >= HIGH_LEVEL) {
+        // All new chunks are equal, so hash of poisoned chunk is calculated once
+        static const hashValue poisonHash = GetSegmentChunkHash(chunk);
+        chunk->dataHash = poisonHash;
+    }
+    else {
+        chunk->dataHash = 0;
+    }
+
+    stack->chunks[stack->chunksCount++] = chunk;
+
+    return 0;
+}
+
+SEGMENTED_TEMPLATE
+int32_t SegmentedStackReleaseChunk(SEGMENTED_TYPE* stack) {
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+
+    int64_t usedChunks = (stack->size + capacity - 1) / capacity;
+    if (stack->chunksCount - usedChunks < 2) return 0;
+
+    stack->chunksCount--;
+    stack->allocator.deallocate(stack->allocator.context, stack->chunks[stack->chunksCount],
+                                sizeof(SegmentChunk<T>));
+    stack->chunks[stack->chunksCount] = nullptr;
+
+    return 0;
+}
+
+template <typename T>
+void SegmentChunkWrite(SegmentChunk<T>* chunk, int64_t elemIdx, T value, int level) {
+    if (level < HIGH_LEVEL) {
+        chunk->data[elemIdx] = value;
+        return;
+    }
+
+    uint8_t* data       = (uint8_t*)chunk->data;
+    uint64_t sizeOfData = SegmentChunk<T>::CAPACITY * sizeof(T);
+
+    uint64_t beginWord  = elemIdx * sizeof(T) / sizeof(uint64_t);
+    uint64_t endWord    = ((elemIdx + 1) * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    chunk->dataHash -= GetWordsHash(data, sizeOfData, beginWord, endWord);
+    chunk->data[elemIdx] = value;
+    chunk->dataHash += GetWordsHash(data, sizeOfData, beginWord, endWord);
+}
+
+template <typename T>
+hashValue GetSegmentChunkHash(SegmentChunk<T>* chunk) {
+    uint64_t sizeOfData = SegmentChunk<T>::CAPACITY * sizeof(T);
+
+    return GetWordsHash((uint8_t*)chunk->data, sizeOfData, 0,
+                        (sizeOfData + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+}
+
+template <typename T>
+StackError IsSegmentChunkOk(SegmentChunk<T>* chunk, int64_t usedCount, int level) {
+    if (chunk == nullptr)                                    return DATA_NULL;
+
+    if (chunk->canaryLeft  != CANARY)                        return LEFT_DATA_CANARY_IRRUPTION;
+    if (chunk->canaryRight != CANARY)                        return RIGHT_DATA_CANARY_IRRUPTION;
+
+    if (level < HIGH_LEVEL)                                  return NO_ERROR;
+
+    if (chunk->dataHash != GetSegmentChunkHash(chunk))       return DATA_HASH_IRRUPTION;
+
+    T poison = StackElemInfo<T>::Poison();
+    if (!IsPatternFilled((uint8_t*)(chunk->data + usedCount), &poison, sizeof(T),
+                         SegmentChunk<T>::CAPACITY - usedCount))
+                                                             return POISON_IRRUPTION;
+
+    return NO_ERROR;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Checks fields of segmented stack structure without chunks
+//-------------------------------------------------------------------------------------------
+
+SEGMENTED_TEMPLATE
+StackError IsSegmentedStructOk(SEGMENTED_TYPE* stack) {
+    if (stack == nullptr)                                    return STACK_NULL;
+
+    if (stack->size == -1 && stack->chunks == nullptr)       return STACK_FREE;
+    if (stack->chunks == nullptr)                            return DATA_NULL;
+
+    if (stack->canaryLeft  != CANARY)                        return LEFT_STACK_CANARY_IRRUPTION;
+    if (stack->canaryRight != CANARY)                        return RIGHT_STACK_CANARY_IRRUPTION;
+
+    if (SegmentedStackLevel(stack) < LOW_LEVEL || SegmentedStackLevel(stack) > HIGH_LEVEL)
+                                                             return LEVEL_INVALID;
+
+    if (stack->chunksCount < 0 || stack->directoryCapacity <= 0)
+                                                             return CAPACITY_NEGATIVE;
+    if (stack->chunksCount > stack->directoryCapacity)       return CAPACITY_INFINITE;
+
+    if (stack->size < 0)                                     return STACK_UNDERFLOW;
+    if (stack->size > stack->chunksCount * SegmentChunk<T>::CAPACITY)
+                                                             return STACK_OVERFLOW;
+
+    return NO_ERROR;
+}
+
+SEGMENTED_TEMPLATE
+StackError IsTopChunkOk(SEGMENTED_TYPE* stack) {
+    if (StackError error = IsSegmentedStructOk(stack))       return error;
+    if (stack->size == 0)                                    return NO_ERROR;
+
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+    int64_t topChunk = (stack->size - 1) / capacity;
+
+    return IsSegmentChunkOk(stack->chunks[topChunk], stack->size - topChunk * capacity, MID_LEVEL);
+}
+
+SEGMENTED_TEMPLATE
+StackError IsTopChunkFullOk(SEGMENTED_TYPE* stack) {
+    if (StackError error = IsSegmentedStructOk(stack))       return error;
+    if (stack->size == 0)                                    return NO_ERROR;
+
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+    int64_t topChunk = (stack->size - 1) / capacity;
+
+    return IsSegmentChunkOk(stack->chunks[topChunk], stack->size - topChunk * capacity,
+                            SegmentedStackLevel(stack));
+}
+
+SEGMENTED_TEMPLATE
+StackError IsAllOk(SEGMENTED_TYPE* stack) {
+    if (StackError error = IsSegmentedStructOk(stack))       return error;
+
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+
+    for (int64_t curChunk = 0; curChunk < stack->chunksCount; curChunk++) {
+        int64_t usedCount = stack->size - curChunk * capacity;
+        usedCount = (usedCount < 0) ? 0 : (usedCount > capacity) ? capacity : usedCount;
+
+        if (StackError error = IsSegmentChunkOk(stack->chunks[curChunk], usedCount,
+                                                SegmentedStackLevel(stack)))
+            return error;
+    }
+
+    return NO_ERROR;
+}
+
+SEGMENTED_TEMPLATE
+int StackDump(SEGMENTED_TYPE* stack, VarInfo dumpInfo, FILE* outstream) {
+    DumpBuffer buffer = {};
+    DumpBufferCtor(&buffer);
+
+    DumpPrintf(&buffer, "Dump from %s() at %s(%d) in stack called now \"%s\": IsAllOk() %s\n",
+               dumpInfo.function, dumpInfo.file, dumpInfo.line, dumpInfo.name,
+               ErrorToString(IsAllOk(stack)));
+
+    if (stack == nullptr) return DumpFinish(&buffer, outstream);
+
+    DumpPrintf(&buffer, "segmented stack <%s> [%p] \"%s\" ",
+               StackElemInfo<T>::NAME, stack, stack->creationInfo.name);
+    DumpPrintf(&buffer, "from %s (%d), %s(): {\n",
+               stack->creationInfo.file,  stack->creationInfo.line, stack->creationInfo.function);
+
+    const int64_t capacity = SegmentChunk<T>::CAPACITY;
+
+    DumpPrintf(&buffer, "level         = %d\n",     SegmentedStackLevel(stack));
+    DumpPrintf(&buffer, "size          = %lld\n",   (long long)stack->size);
+    DumpPrintf(&buffer, "chunk         = %lld elements\n", (long long)capacity);
+    DumpPrintf(&buffer, "chunks        = %lld\n",   (long long)stack->chunksCount);
+    DumpPrintf(&buffer, "directory     = %lld\n\n", (long long)stack->directoryCapacity);
+
+    DumpPrintf(&buffer, "Stack canaries:\n");
+    DumpPrintf(&buffer, "    canaryLeft[%p] = %ud (%s)\n",
+               &stack->canaryLeft,  stack->canaryLeft,  (stack->canaryLeft  == CANARY) ?
+               "Ok" : "IRRUPTION");
+    DumpPrintf(&buffer, "    canaryRight[%p] = %ud (%s)\n\n",
+               &stack->canaryRight, stack->canaryRight, (stack->canaryRight == CANARY) ?
+               "Ok" : "IRRUPTION");
+
+    if (stack->chunks == nullptr) {
+        DumpPrintf(&buffer, "chunks[nullptr]\n");
+        return DumpFinish(&buffer, outstream);
+    }
+
+    bool isSizeOk = stack->size >= 0 && stack->chunksCount >= 0 &&
+                    stack->chunksCount <= stack->directoryCapacity &&
+                    stack->size <= stack->chunksCount * capacity;
+
+    for (int64_t curChunk = 0; isSizeOk && curChunk < stack->chunksCount; curChunk++) {
+        SegmentChunk<T>* chunk = stack->chunks[curChunk];
+
+        DumpPrintf(&buffer, "chunk[%lld][%p] ", (long long)curChunk, chunk);
+        if (chunk == nullptr) {
+            DumpPrintf(&buffer, "\n");
+            continue;
+        }
+
+        DumpPrintf(&buffer, "canaries %ud %ud (%s), ", chunk->canaryLeft, chunk->canaryRight,
+                   (chunk->canaryLeft == CANARY && chunk->canaryRight == CANARY) ? "Ok" : "IRRUPTION");
+
+        if (SegmentedStackLevel(stack) >= HIGH_LEVEL) {
+            hashValue currentHash = GetSegmentChunkHash(chunk);
+            DumpPrintf(&buffer, "hash %llu (%s)\n", (unsigned long long)chunk->dataHash,
+                       (chunk->dataHash == currentHash) ? "Ok" : "IRRUPTION");
+        }
+        else {
+            DumpPrintf(&buffer, "hash isn't kept\n");
+        }
+
+        DumpPrintf(&buffer, "{\n");
+
+        int64_t usedCount = stack->size - curChunk * capacity;
+        usedCount = (usedCount < 0) ? 0 : (usedCount > capacity) ? capacity : usedCount;
+
+        for (int64_t curIdx = 0; curIdx < usedCount; curIdx++) {
+            DumpPrintf(&buffer, "   *[%lld][%p] = ", (long long)(curChunk * capacity + curIdx),
+                       &chunk->data[curIdx]);
+            StackElemInfo<T>::Print(&buffer, chunk->data[curIdx]);
+            DumpPrintf(&buffer, "\n");
+        }
+
+        DumpPrintf(&buffer, "}\n");
+    }
+
+    DumpPrintf(&buffer, "}\n");
+
+    return DumpFinish(&buffer, outstream);
+}
+
+#endif
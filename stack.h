@@ -6,65 +6,126 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-#define LOW_LEVEL  1
-#define MID_LEVEL  2
-#define HIGH_LEVEL 3
+#include "stack_alloc.h"
+#include "stack_dump.h"
 
-#define STACK_DEBUG 3
+#define DYNAMIC_LEVEL 0
+#define LOW_LEVEL     1
+#define MID_LEVEL     2
+#define HIGH_LEVEL    3
 
 #ifndef STACK_DEBUG
-    #define STACK_DEBUG LOW_LEVEL
+    #define STACK_DEBUG HIGH_LEVEL
 #endif
 
-#if (STACK_DEBUG >= LOW_LEVEL)
-    #define LOCATION(...) , { __FILE__, __FUNCTION__, __LINE__, #__VA_ARGS__ }
+#define FULL_HASH_CHECK  1
+#define DIRTY_HASH_CHECK 2
+
+// FULL_HASH_CHECK rehashes the whole data on every check, so HIGH level push and pop cost
+// O(capacity). DIRTY_HASH_CHECK rehashes only words changed since the last full check
+#ifndef STACK_HASH_CHECK
+    #define STACK_HASH_CHECK DIRTY_HASH_CHECK
+#endif
+
+#define POLY_HASH   1
+#define XX_HASH     2
+#define CRC32C_HASH 3
+
+#ifndef STACK_HASH
+    #define STACK_HASH XX_HASH
+#endif
+
+#ifndef STACK_STATS
+    #define STACK_STATS 0
+#endif
+
+#if (STACK_STATS)
+    #define StatsAdd(stack, counter, value) ((stack)->stats.counter += (value))
+    #define StatsMax(stack, counter, value)                                   \
+        ((stack)->stats.counter = ((stack)->stats.counter < (value)) ? (value) : (stack)->stats.counter)
+    #define StatsNow() GetTimeNs()
 #else
-    #define LOCATION(...)
+    #define StatsAdd(stack, counter, value) ((void)(value))
+    #define StatsMax(stack, counter, value) ((void)(value))
+    #define StatsNow() 0
 #endif
 
+#define LOCATION(...) , { __FILE__, __FUNCTION__, __LINE__, #__VA_ARGS__ }
+
 #define StackCtor(stack)                           \
-    Stack stack = {};                              \
+    Stack<StackElem> stack = {};                   \
     StackCtor_(&stack LOCATION (stack));
 
-#define CheckAllStack(stack)                                                                  \
-    if (StackError error = IsAllOk(stack)) {                                                  \
+#define StackCtorPolicy(stack, policy)             \
+    Stack<StackElem> stack = {};                   \
+    StackCtor_(&stack LOCATION (stack), policy);
+
+#define StackCtorAlloc(stack, allocator)                                   \
+    Stack<StackElem> stack = {};                                           \
+    StackCtor_(&stack LOCATION (stack), DEFAULT_GROWTH_POLICY, STACK_DEBUG, allocator);
+
+#define StackCtorInline(stack, inlineCapacity)     \
+    Stack<StackElem, STACK_DEBUG, inlineCapacity> stack = {}; \
+    StackCtor_(&stack LOCATION (stack));
+
+#define StackCtorType(stack, type, level)          \
+    Stack<type, level> stack = {};                 \
+    StackCtor_(&stack LOCATION (stack));
+
+#define StackCtorLevel(stack, type, level)                                 \
+    Stack<type, DYNAMIC_LEVEL> stack = {};                                 \
+    StackCtor_(&stack LOCATION (stack), DEFAULT_GROWTH_POLICY, level);
+
+#define StackCtorCapacity(stack, type, capacity)   \
+    Stack<type> stack = {};                        \
+    StackCtor_(&stack LOCATION (stack), (int32_t)(capacity));
+
+#define StackCtorAdaptive(stack, type)             \
+    Stack<type> stack = {};                        \
+    StackCtor_(&stack LOCATION (stack), ADAPTIVE_GROWTH_POLICY);
+
+#define StackClone(clone, source)                  \
+    decltype(source) clone = {};                   \
+    StackClone_(&clone, &source LOCATION (clone), (source).allocator);
+
+#define CheckStack(stack, checker)                                                            \
+    if (StackError error = checker(stack)) {                                                  \
         printf("Error %s, read full description in dump file\n", ErrorToString(error));       \
                                                                                               \
         StackDump(stack LOCATION (stack));                                                   \
         assert(!"OK" && "Verify failed");                                                     \
     }
 
-typedef uint32_t canary;
-typedef uint64_t hashValue;
-typedef int32_t StackElem;
+#define CheckAllStack(stack) CheckStack(stack, IsAllOkScheduled)
 
-#if (STACK_DEBUG == HIGH_LEVEL)
-    const uint32_t SHIFT = sizeof(canary) + 2 * sizeof(hashValue);
-    const uint32_t PROTECTION_SIZE = 2 * (sizeof(canary) + sizeof(hashValue));
-#endif
-
-#if (STACK_DEBUG == MID_LEVEL)
-    const uint32_t SHIFT = sizeof(canary);
-    const uint32_t PROTECTION_SIZE = 2 * sizeof(canary);
-#endif
+#define STACK_TEMPLATE template <typename T, int Level, int32_t InlineCapacity>
+#define STACK_TYPE     Stack<T, Level, InlineCapacity>
 
-#if (STACK_DEBUG == LOW_LEVEL)
-    const uint32_t SHIFT = 0;
-    const uint32_t PROTECTION_SIZE = 0;
+typedef uint32_t canary;
+#if (STACK_HASH == CRC32C_HASH)
+    typedef uint32_t hashValue;
+#else
+    typedef uint64_t hashValue;
 #endif
+typedef int32_t StackElem;
 
 const uint32_t POISON     = 0xE2202;
+const uint8_t POISON_BYTE = 0xE2;
 const canary CANARY       = 0xDEAD;
 const uint32_t FREE_VALUE = 0xF2EE;
 
 const uint32_t STACK_BEGINNING_CAPACITY = 50;
 const uint32_t HASH_BASE = 257;
 
+const uint64_t HASH_WORD_MULTIPLIER = 0x9E3779B97F4A7C15;
+const uint64_t HASH_MIX_FIRST       = 0xFF51AFD7ED558CCD;
+const uint64_t HASH_MIX_SECOND      = 0xC4CEB9FE1A85EC53;
+
 const float INCREASE_MULTIPLIER = 1.5;
 const float DECREASE_MULTIPLIER = 2;
-
-const char* NAME_OF_STACK_TYPE = "int";
+const float DECREASE_THRESHOLD  = 4;
 
 enum StackError {
     NO_ERROR = 0,
@@ -80,7 +141,13 @@ enum StackError {
     LEFT_DATA_CANARY_IRRUPTION,
     RIGHT_DATA_CANARY_IRRUPTION,
     STACK_HASH_IRRUPTION,
-    DATA_HASH_IRRUPTION
+    DATA_HASH_IRRUPTION,
+    LEVEL_INVALID,
+    POISON_IRRUPTION,
+    FILE_INVALID,
+    PROGRAM_INVALID,
+    DIVISION_BY_ZERO,
+    DIVISION_OVERFLOW
 };
 
 struct VarInfo {
@@ -91,40 +158,371 @@ struct VarInfo {
     const char* name;
 };
 
-struct Stack {
-#if (STACK_DEBUG >= MID_LEVEL)
-    canary canaryLeft;
-#endif
+//-------------------------------------------------------------------------------------------
+//! How stack changes its capacity
+//!
+//! @note Adaptive stack starts with capacity remembered from peak sizes of stacks which were
+//!       created in the same place before
+//-------------------------------------------------------------------------------------------
+
+struct GrowthPolicy {
+    float increaseMultiplier;
+    float decreaseMultiplier;
+    float decreaseThreshold;
+
+    int32_t minCapacity;
+
+    bool isAdaptive;
+};
+
+const GrowthPolicy DEFAULT_GROWTH_POLICY = {
+    INCREASE_MULTIPLIER,
+    DECREASE_MULTIPLIER,
+    DECREASE_THRESHOLD,
+    STACK_BEGINNING_CAPACITY,
+    false
+};
+
+const GrowthPolicy ADAPTIVE_GROWTH_POLICY = {
+    INCREASE_MULTIPLIER,
+    DECREASE_MULTIPLIER,
+    DECREASE_THRESHOLD,
+    STACK_BEGINNING_CAPACITY,
+    true
+};
+
+enum VerifyMode {
+    VERIFY_ALWAYS = 0,
+    VERIFY_EVERY_NTH,
+    VERIFY_RANDOM,
+    VERIFY_TIME_BUDGET
+};
+
+struct VerifyPolicy {
+    VerifyMode mode;
+
+    uint32_t period;
+    float probability;
+    float budgetShare;
+};
+
+const VerifyPolicy DEFAULT_VERIFY_POLICY = {
+    VERIFY_ALWAYS,
+    1,
+    1,
+    1
+};
+
+struct VerifyState {
+    uint64_t counter;
+    uint64_t randomState;
+
+    uint64_t startTime;
+    uint64_t checkTime;
+
+    bool isVerified;
+    int32_t scopeDepth;
+};
+
+const uint32_t STATS_HISTOGRAM_SIZE = 32;
 
-#if (STACK_DEBUG >= LOW_LEVEL)
+//-------------------------------------------------------------------------------------------
+//! Counters of stack behaviour, they are gathered only with STACK_STATS
+//!
+//! @note popSizes[i] counts pops from stack which size had i significant bits
+//-------------------------------------------------------------------------------------------
+
+struct StackStats {
+    uint64_t stacks;
+
+    uint64_t pushes;
+    uint64_t pops;
+
+    uint64_t increases;
+    uint64_t decreases;
+    uint64_t reallocBytes;
+    int32_t  peakSize;
+
+    uint64_t checks;
+    uint64_t checkTime;
+    uint64_t hashChecks;
+    uint64_t hashTime;
+
+    uint64_t popSizes[STATS_HISTOGRAM_SIZE];
+};
+
+//-------------------------------------------------------------------------------------------
+//! Stats and capacity hint of all stacks created in one place
+//-------------------------------------------------------------------------------------------
+
+struct StatsSite {
     VarInfo creationInfo;
-#endif
+    StackStats stats;
+
+    int32_t capacityHint;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Describes stack element type: its name, poison value and dump format
+//!
+//! @note Default version suits any POD type: poison is POISON_BYTE in every byte and
+//!       element is dumped as hex bytes. Specialize it for types with readable format
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct StackElemInfo {
+    static constexpr const char* NAME = "pod";
+
+    static T Poison() {
+        T poison;
+        memset((void*)&poison, POISON_BYTE, sizeof(T));
+
+        return poison;
+    }
+
+    static void Print(DumpBuffer* buffer, const T& elem) {
+        const uint8_t* elemBytes = (const uint8_t*)&elem;
+
+        for (uint32_t curByte = 0; curByte < sizeof(T); curByte++) {
+            DumpPrintf(buffer, "%02X", elemBytes[curByte]);
+        }
+    }
+};
+
+template <>
+struct StackElemInfo<int32_t> {
+    static constexpr const char* NAME = "int";
+
+    static int32_t Poison()                                   { return POISON; }
+    static void Print(DumpBuffer* buffer, const int32_t& elem) { DumpPrintf(buffer, "%d", elem); }
+};
+
+template <>
+struct StackElemInfo<int64_t> {
+    static constexpr const char* NAME = "int64_t";
+
+    static int64_t Poison()                                   { return POISON; }
+    static void Print(DumpBuffer* buffer, const int64_t& elem) { DumpPrintf(buffer, "%lld", (long long)elem); }
+};
+
+template <>
+struct StackElemInfo<double> {
+    static constexpr const char* NAME = "double";
+
+    static double Poison() {
+        uint64_t poisonBits = 0x7FF0000000000000 | POISON;
+
+        double poison = 0;
+        memcpy(&poison, &poisonBits, sizeof(poison));
+
+        return poison;
+    }
+
+    static void Print(DumpBuffer* buffer, const double& elem)  { DumpPrintf(buffer, "%lg", elem); }
+};
+
+template <typename T>
+struct StackElemInfo<T*> {
+    static constexpr const char* NAME = "pointer";
+
+    static T* Poison()                                        { return (T*)(uintptr_t)POISON; }
+    static void Print(DumpBuffer* buffer, T* const& elem)      { DumpPrintf(buffer, "%p", (void*)elem); }
+};
+
+//-------------------------------------------------------------------------------------------
+//! Gets amount of bytes in data storage before the first element
+//!
+//! @param [in] level Protection level of stack
+//!
+//! @return Left data canary and hashes size rounded up to DATA_ALIGNMENT
+//!
+//! @note Canary is at the beginning of storage and hashes are just before the first element,
+//!       so elements of aligned storage start at cache line
+//-------------------------------------------------------------------------------------------
+
+constexpr uint32_t GetShift(int level) {
+    return (level >= MID_LEVEL) ?
+           (uint32_t)(((level >= HIGH_LEVEL) ? sizeof(canary) + 2 * sizeof(hashValue) :
+                                               sizeof(canary)) + DATA_ALIGNMENT - 1) /
+           DATA_ALIGNMENT * DATA_ALIGNMENT : 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Gets amount of service bytes in data storage
+//!
+//! @param [in] level Protection level of stack
+//!
+//! @return Left data canary and hashes with their padding and right data canary size
+//-------------------------------------------------------------------------------------------
+
+constexpr uint32_t GetProtectionSize(int level) {
+    return (level >= MID_LEVEL) ? GetShift(level) + sizeof(canary) : 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Stack of T elements
+//!
+//! @note Level is LOW_LEVEL, MID_LEVEL or HIGH_LEVEL protection of this stack, stacks with
+//!       different levels can live in one program. Default level is STACK_DEBUG
+//!       DYNAMIC_LEVEL stack gets its level in StackCtor_ and keeps it in level field
+//!       verifyState changes on every check, so it lies out of canaries and stack hash
+//!       Stack with InlineCapacity > 0 keeps its first InlineCapacity elements with data
+//!       canaries and hashes in inlineData and moves them to allocator memory on overflow
+//!       Stack can't be copied, because copy would share data. It can be moved, moved-from
+//!       stack is destroyed
+//!       Fields which push and pop read are in the first cache line, creationInfo is the last
+//!       one under stack hash. Stack takes whole cache lines, so neighbour stacks of
+//!       different threads don't share them
+//-------------------------------------------------------------------------------------------
+
+template <typename T, int Level = STACK_DEBUG, int32_t InlineCapacity = 0>
+struct alignas(CACHE_LINE_SIZE) Stack {
+    typedef T Elem;
+
+    Stack() = default;
+
+    Stack(const Stack& other)            = delete;
+    Stack& operator=(const Stack& other) = delete;
+
+    Stack(Stack&& other);
+    Stack& operator=(Stack&& other);
+
+    canary canaryLeft;
+
+    int32_t level;
+    uint8_t* data;
 
     int32_t size;
     int32_t capacity;
-    uint8_t* data;
 
-#if (STACK_DEBUG >= MID_LEVEL)
+    VerifyPolicy verifyPolicy;
+    GrowthPolicy policy;
+
+    StackAllocator allocator;
+
+#if (STACK_HASH_CHECK == DIRTY_HASH_CHECK)
+    hashValue cleanHash;
+    uint64_t dirtyBegin;
+    uint64_t dirtyEnd;
+#endif
+
+    VarInfo creationInfo;
+
     canary canaryRight;
+
+    VerifyState verifyState;
+    int32_t peakSize;
+
+#if (STACK_STATS)
+    StackStats stats;
 #endif
+
+    alignas(DATA_ALIGNMENT) uint8_t inlineData[InlineCapacity ?
+        GetProtectionSize((Level == DYNAMIC_LEVEL) ? HIGH_LEVEL : Level) + InlineCapacity * sizeof(T) : 1];
 };
 
+static_assert(offsetof(Stack<StackElem>, policy) + sizeof(GrowthPolicy) <= CACHE_LINE_SIZE,
+              "Fields of push and pop don't fit first cache line");
+
+//-------------------------------------------------------------------------------------------
+//! Gets protection level of stack
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return Level template parameter or level field for DYNAMIC_LEVEL stack
+//!
+//! @note Level of non-dynamic stack is known at compile time, so checks of other levels
+//!       are thrown away by compiler
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+inline int StackLevel(const STACK_TYPE* stack) {
+    return (Level == DYNAMIC_LEVEL) ? stack->level : Level;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Gets amount of bytes in data storage of stack before the first element
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return Left data canary and hashes size
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+inline uint32_t StackShift(const STACK_TYPE* stack) {
+    return GetShift(StackLevel(stack));
+}
+
+//-------------------------------------------------------------------------------------------
+//! Gets amount of service bytes in data storage of stack
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return Data canaries and hashes size
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+inline uint32_t StackProtectionSize(const STACK_TYPE* stack) {
+    return GetProtectionSize(StackLevel(stack));
+}
+
+//-------------------------------------------------------------------------------------------
+//! Checks if stack data is kept in stack structure
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return true if data is in inlineData
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+inline bool IsStackInline(const STACK_TYPE* stack) {
+    return InlineCapacity > 0 && stack->data - StackShift(stack) == stack->inlineData;
+}
+
 //-------------------------------------------------------------------------------------------
 //! Creates stack from StackCtor macro
 //!
 //! @param [in] stack Pointer to the stack structure which will be created
+//! @param [in] policy Growth policy of stack (use StackCtorPolicy macro to set it)
+//! @param [in] level Protection level, must be equal to Level if it isn't DYNAMIC_LEVEL
+//!                   (use StackCtorLevel macro to set it)
+//! @param [in] allocator Source of data memory (use StackCtorAlloc macro to set it)
 //!
 //! @return 0 if no errors
 //!
 //! @note You should type in macro StackCtor name of future stack without quotation marks
-//!       You can change POISON value if stack element type has unreachable value
+//!       You can change poison value in StackElemInfo if element type has unreachable value
+//!       Stack grows when it is full and shrinks when it is filled less than
+//!       1 / decreaseThreshold, so decreaseThreshold must be bigger than both multipliers
+//!       Elements start at DATA_ALIGNMENT if allocator gives aligned blocks (all allocators
+//!       except guard one, which puts end of block at guard page)
 //-------------------------------------------------------------------------------------------
 
-#if (STACK_DEBUG >= LOW_LEVEL)
-    int32_t StackCtor_(Stack* stack, VarInfo);
-#else
-    int32_t StackCtor_(Stack* stack);
-#endif
+STACK_TEMPLATE
+int32_t StackCtor_(STACK_TYPE* stack, VarInfo creationInfo, GrowthPolicy policy = DEFAULT_GROWTH_POLICY,
+                   int level = (Level == DYNAMIC_LEVEL) ? STACK_DEBUG : Level,
+                   StackAllocator allocator = MALLOC_ALLOCATOR);
+
+//-------------------------------------------------------------------------------------------
+//! Creates stack with initial capacity from StackCtorCapacity macro
+//!
+//! @param [in] stack Pointer to the stack structure which will be created
+//! @param [in] capacity Initial capacity, 0 means default one (InlineCapacity,
+//!                      capacity hint of adaptive stack or policy.minCapacity)
+//! @param [in] policy Growth policy of stack
+//! @param [in] level Protection level, must be equal to Level if it isn't DYNAMIC_LEVEL
+//! @param [in] allocator Source of data memory
+//!
+//! @return 0 if no errors
+//!
+//! @note Stack with InlineCapacity keeps data inline if capacity fits in it
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackCtor_(STACK_TYPE* stack, VarInfo creationInfo, int32_t capacity,
+                   GrowthPolicy policy = DEFAULT_GROWTH_POLICY,
+                   int level = (Level == DYNAMIC_LEVEL) ? STACK_DEBUG : Level,
+                   StackAllocator allocator = MALLOC_ALLOCATOR);
 
 //-------------------------------------------------------------------------------------------
 //! Destroys stack
@@ -134,30 +532,185 @@ struct Stack {
 //! @return 0 if no errors
 //-------------------------------------------------------------------------------------------
 
-int32_t StackDtor(Stack* stack);
+STACK_TEMPLATE
+int32_t StackDtor(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
 //! Pushes element in stack
 //!
 //! @param [in] stack Pointer to the stack where element will be pushed
-//! @param [in] pushedValue StackElem variable which will be pushed
+//! @param [in] pushedValue Element which will be pushed
 //!
 //! @return 0 if no errors
 //!
 //! @note Memory of stack can be increased if size >= value by StackIncrease function
 //-------------------------------------------------------------------------------------------
 
-int32_t StackPush(Stack* stack, StackElem pushedValue);
+STACK_TEMPLATE
+int32_t StackPush(STACK_TYPE* stack, typename STACK_TYPE::Elem pushedValue);
 
 //-------------------------------------------------------------------------------------------
 //! Pops element from stack
 //!
 //! @param [in] stack Pointer to the stack where from element will be popped
 //!
-//! @return StackElem  - popped value
+//! @return Popped value
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+T StackPop(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Pushes count elements in stack with one check and one copy
+//!
+//! @param [in] stack Pointer to the stack where elements will be pushed
+//! @param [in] pushedValues Array of elements, pushedValues[0] is pushed first
+//! @param [in] count Amount of pushed elements
+//!
+//! @return 0 if no errors
+//!
+//! @note Memory of stack is increased at most once
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackPushN(STACK_TYPE* stack, const T* pushedValues, int32_t count);
+
+//-------------------------------------------------------------------------------------------
+//! Moves stack to other place, source stack becomes destroyed
+//!
+//! @param [out] dest Pointer to the place, its old content is overwritten
+//! @param [in]  source Pointer to the stack
+//!
+//! @note Only inline data is copied, data in allocator memory stays where it is, so move
+//!       takes O(1) and stack hash is rewritten because data pointer is changed.
+//!       Allocator relocate hook is told about new place of stack
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+void StackRelocate(STACK_TYPE* dest, STACK_TYPE* source);
+
+//-------------------------------------------------------------------------------------------
+//! Exchanges content of two stacks
+//!
+//! @param [in] first Pointer to the first stack
+//! @param [in] second Pointer to the second stack
+//!
+//! @return 0 if no errors
+//!
+//! @note Takes O(1) besides checks, inline stacks exchange their inline data
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackSwap(STACK_TYPE* first, STACK_TYPE* second);
+
+//-------------------------------------------------------------------------------------------
+//! Creates copy of stack from StackClone macro
+//!
+//! @param [out] clone Pointer to the stack structure which will be created
+//! @param [in]  source Pointer to the copied stack
+//! @param [in]  allocator Source of data memory of clone (macro takes allocator of source)
+//!
+//! @return 0 if no errors
+//!
+//! @note Only size live elements are copied and hashed, clone gets capacity enough for them
+//!       and policy and level of source. Single block allocator of source (stack in file)
+//!       is replaced with MALLOC_ALLOCATOR
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackClone_(STACK_TYPE* clone, STACK_TYPE* source, VarInfo creationInfo, StackAllocator allocator);
+
+//-------------------------------------------------------------------------------------------
+//! Makes capacity of stack at least capacity elements
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] capacity Needed capacity
+//!
+//! @return 0 if no errors
+//!
+//! @note Reserved capacity becomes minimal capacity of stack, so pops don't shrink it
+//!       until StackShrinkToFit
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackReserve(STACK_TYPE* stack, int32_t capacity);
+
+//-------------------------------------------------------------------------------------------
+//! Makes capacity of stack equal to its size
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return 0 if no errors
+//!
+//! @note Inline stack keeps its capacity, empty stack keeps one element
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackShrinkToFit(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Pops count elements from stack with one check and one copy
+//!
+//! @param [in]  stack Pointer to the stack where from elements will be popped
+//! @param [out] poppedValues Array for popped elements, they are written in order of pushing
+//!                           (last popped value is poppedValues[0])
+//! @param [in]  count Amount of popped elements
+//!
+//! @return 0 if no errors
+//!
+//! @note Memory of stack is decreased at most once
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackPopN(STACK_TYPE* stack, T* poppedValues, int32_t count);
+
+//-------------------------------------------------------------------------------------------
+//! Pushes element without checks and hash update, must be called inside StackVerifyScope
+//!
+//! @param [in] stack Pointer to the stack where element will be pushed
+//! @param [in] pushedValue Element which will be pushed
+//!
+//! @note Hashes are rewritten only when stack grows and at the end of scope
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+inline void StackPushFast(STACK_TYPE* stack, typename STACK_TYPE::Elem pushedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Pops element without checks and hash update, must be called inside StackVerifyScope
+//!
+//! @param [in] stack Pointer to the stack where from element will be popped
+//!
+//! @return Popped value
+//!
+//! @note Freed cell is poisoned as in StackPop, stack doesn't shrink until end of scope
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+inline T StackPopFast(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Scope where stack is checked only at entry and exit
+//!
+//! @note Constructor checks stack with IsAllOk, destructor rewrites hashes, shrinks stack if
+//!       it is too big and checks it again. Inside scope CheckAllStack checks nothing, so
+//!       StackPushFast, StackPopFast and usual functions can be mixed. Scopes can be nested,
+//!       only the outer one checks. Stack can't be moved or dumped inside scope, its hashes
+//!       are stale there
+//!
+//!       StackVerifyScope scope(&stack);
 //-------------------------------------------------------------------------------------------
 
-StackElem StackPop(Stack* stack);
+STACK_TEMPLATE
+struct StackVerifyScope {
+    STACK_TYPE* stack;
+
+    explicit StackVerifyScope(STACK_TYPE* stack);
+    ~StackVerifyScope();
+
+    StackVerifyScope(const StackVerifyScope& other)            = delete;
+    StackVerifyScope& operator=(const StackVerifyScope& other) = delete;
+};
 
 //-------------------------------------------------------------------------------------------
 //! Checks if stack structure is OK
@@ -169,7 +722,8 @@ StackElem StackPop(Stack* stack);
 //! @note Returns NO_ERROR if stack is OK (For all check functions)
 //-------------------------------------------------------------------------------------------
 
-StackError IsStackOk(Stack* stack);
+STACK_TEMPLATE
+StackError IsStackOk(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
 //! Checks if data of stack is OK
@@ -179,7 +733,8 @@ StackError IsStackOk(Stack* stack);
 //! @return One of StackError
 //-------------------------------------------------------------------------------------------
 
-StackError IsDataOk(Stack* stack);
+STACK_TEMPLATE
+StackError IsDataOk(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
 //! Checks if capacity of stack is OK
@@ -189,7 +744,8 @@ StackError IsDataOk(Stack* stack);
 //! @return One of StackError
 //-------------------------------------------------------------------------------------------
 
-StackError IsCapacityOk(Stack* stack);
+STACK_TEMPLATE
+StackError IsCapacityOk(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
 //! Checks if size of stack is OK
@@ -199,7 +755,8 @@ StackError IsCapacityOk(Stack* stack);
 //! @return One of StackError
 //-------------------------------------------------------------------------------------------
 
-StackError IsSizeOk(Stack* stack);
+STACK_TEMPLATE
+StackError IsSizeOk(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
 //! Checks if canaries of stack are OK
@@ -209,7 +766,8 @@ StackError IsSizeOk(Stack* stack);
 //! @return One of StackError
 //-------------------------------------------------------------------------------------------
 
-StackError IsCanariesOk(Stack* stack);
+STACK_TEMPLATE
+StackError IsCanariesOk(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
 //! Checks if hashes of stack are OK
@@ -219,7 +777,35 @@ StackError IsCanariesOk(Stack* stack);
 //! @return One of StackError
 //-------------------------------------------------------------------------------------------
 
-StackError IsHashesOk(Stack* stack);
+STACK_TEMPLATE
+StackError IsHashesOk(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Checks stored data hash against hash of the whole data
+//!
+//! @param [in] stack Pointer to the stack which data hash will be checked
+//!
+//! @return One of StackError
+//!
+//! @note IsHashesOk checks only dirty words if STACK_HASH_CHECK is DIRTY_HASH_CHECK,
+//!       this function always rehashes full data
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+StackError IsDataHashOk(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Checks that all elements after size are poison
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return One of StackError
+//!
+//! @note Poison is written only on HIGH_LEVEL, so lower levels always pass
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+StackError IsPoisonOk(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
 //! Checks if all components of stack are OK
@@ -229,7 +815,36 @@ StackError IsHashesOk(Stack* stack);
 //! @return One of StackError
 //-------------------------------------------------------------------------------------------
 
-StackError IsAllOk(Stack* stack);
+STACK_TEMPLATE
+StackError IsAllOk(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Checks all components of stack if verify policy of stack says it is time to check
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return One of StackError, NO_ERROR if check was skipped
+//!
+//! @note VERIFY_ALWAYS checks every time, VERIFY_EVERY_NTH checks every period-th time,
+//!       VERIFY_RANDOM checks with probability, VERIFY_TIME_BUDGET checks while time of
+//!       checks is lower than budgetShare of stack lifetime. CheckAllStack uses this function
+//!       Nothing is checked inside StackVerifyScope
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+StackError IsAllOkScheduled(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Sets verify policy of stack
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] verifyPolicy New verify policy
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackSetVerifyPolicy(STACK_TYPE* stack, VerifyPolicy verifyPolicy);
 
 //-------------------------------------------------------------------------------------------
 //! Gets hash from size bytes after pointer
@@ -238,10 +853,66 @@ StackError IsAllOk(Stack* stack);
 //! @param [in] size Amount of bytes which will be included in hash calculating
 //!
 //! @return Calculated hash
+//!
+//! @note Hash function is chosen by STACK_HASH: POLY_HASH, XX_HASH (default) or
+//!       CRC32C_HASH, see stack_hash.h
 //-------------------------------------------------------------------------------------------
 
 hashValue GetHash(uint8_t* pointer, uint64_t size);
 
+//-------------------------------------------------------------------------------------------
+//! Gets hash of one 8-byte word of data
+//!
+//! @param [in] wordIdx Index of word in data
+//! @param [in] word Value of word
+//!
+//! @return Calculated word hash
+//!
+//! @note Data hash is the sum of its word hashes, so it can be updated word by word
+//-------------------------------------------------------------------------------------------
+
+hashValue GetWordHash(uint64_t wordIdx, uint64_t word);
+
+//-------------------------------------------------------------------------------------------
+//! Gets sum of word hashes in [beginWord, endWord) range of data
+//!
+//! @param [in] data Pointer to the beginning of data
+//! @param [in] sizeOfData Amount of bytes in data, last word is padded with zeroes
+//! @param [in] beginWord Index of first hashed word
+//! @param [in] endWord Index of word after last hashed one
+//!
+//! @return Calculated range hash
+//-------------------------------------------------------------------------------------------
+
+hashValue GetWordsHash(uint8_t* data, uint64_t sizeOfData, uint64_t beginWord, uint64_t endWord);
+
+//-------------------------------------------------------------------------------------------
+//! Writes count copies of pattern in dest
+//!
+//! @param [in] dest Pointer to the memory
+//! @param [in] pattern Pointer to the pattern
+//! @param [in] patternSize Size of pattern
+//! @param [in] count Amount of copies
+//!
+//! @note GetHash, GetWordsHash, FillPattern and IsPatternFilled use SSE2/AVX2 kernels
+//!       if CPU supports them, see stack_simd.h
+//-------------------------------------------------------------------------------------------
+
+void FillPattern(uint8_t* dest, const void* pattern, uint32_t patternSize, uint64_t count);
+
+//-------------------------------------------------------------------------------------------
+//! Checks that src is count copies of pattern
+//!
+//! @param [in] src Pointer to the memory
+//! @param [in] pattern Pointer to the pattern
+//! @param [in] patternSize Size of pattern
+//! @param [in] count Amount of copies
+//!
+//! @return true if all copies are equal to pattern
+//-------------------------------------------------------------------------------------------
+
+bool IsPatternFilled(const uint8_t* src, const void* pattern, uint32_t patternSize, uint64_t count);
+
 //-------------------------------------------------------------------------------------------
 //! Gets hash from stack structure
 //!
@@ -250,7 +921,8 @@ hashValue GetHash(uint8_t* pointer, uint64_t size);
 //! @return Calculated stack structure hash
 //-------------------------------------------------------------------------------------------
 
-hashValue GetStackHash(Stack* stack);
+STACK_TEMPLATE
+hashValue GetStackHash(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
 //! Gets hash from stack data
@@ -260,7 +932,8 @@ hashValue GetStackHash(Stack* stack);
 //! @return Calculated stack data hash
 //-------------------------------------------------------------------------------------------
 
-hashValue GetDataHash(Stack* stack);
+STACK_TEMPLATE
+hashValue GetDataHash(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
 //! Calculates new stack and data hashed and writes their values in storage (located in data)
@@ -268,18 +941,119 @@ hashValue GetDataHash(Stack* stack);
 //! @param [in] stack Pointer to the stack which fully will be hashed
 //-------------------------------------------------------------------------------------------
 
-void WriteAllStackHash(Stack* stack);
+STACK_TEMPLATE
+void WriteAllStackHash(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Calculates new stack structure hash and writes it in storage (located in data)
+//!
+//! @param [in] stack Pointer to the stack which structure will be hashed
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+void WriteStackHash(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Subtracts hash of words with elements in [beginIdx, endIdx) from stored data hash
+//!
+//! @param [in] stack Pointer to the stack which elements will be changed
+//! @param [in] beginIdx Index of first element
+//! @param [in] endIdx Index of element after last one
+//!
+//! @note Call it before changing elements and AddElemsToHash after it
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+void RemoveElemsFromHash(STACK_TYPE* stack, int32_t beginIdx, int32_t endIdx);
+
+//-------------------------------------------------------------------------------------------
+//! Adds hash of words with elements in [beginIdx, endIdx) to stored data hash
+//!
+//! @param [in] stack Pointer to the stack which elements were changed
+//! @param [in] beginIdx Index of first element
+//! @param [in] endIdx Index of element after last one
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+void AddElemsToHash(STACK_TYPE* stack, int32_t beginIdx, int32_t endIdx);
 
 //-------------------------------------------------------------------------------------------
-//! Writes full stack dump in outstream
+//! Marks all words of verified stack as clean
+//!
+//! @param [in] stack Pointer to the stack which hashes were just checked
+//!
+//! @note Call it only after successful IsHashesOk, then next check rehashes only words
+//!       changed after this call
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+void ResetDirtyHash(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Writes poison in [beginIdx, endIdx) elements
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] beginIdx Index of the first poisoned element
+//! @param [in] endIdx Index after the last poisoned element
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+void StackFillPoison(STACK_TYPE* stack, int32_t beginIdx, int32_t endIdx);
+
+//-------------------------------------------------------------------------------------------
+//! Renders stack dump in buffer and writes it in outstream in one go
 //!
 //! @param [in] stack Pointer to the stack which will be dumped
 //! @param [in] outstream Pointer to the stream where dump will be written (default is stdout)
+//! @param [in] options Format and shown elements of dump (default is full text dump)
 //!
 //! @return 0 if all OK
+//!
+//! @note Buffering of outstream isn't changed
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int StackDump(STACK_TYPE* stack, VarInfo dumpInfo, FILE* outstream = stdout,
+              DumpOptions options = DEFAULT_DUMP_OPTIONS);
+
+//-------------------------------------------------------------------------------------------
+//! Renders stack dump in buffer
+//!
+//! @param [in] stack Pointer to the stack which will be dumped
+//! @param [in] buffer Pointer to the buffer, dump is appended to it
+//! @param [in] options Format and shown elements of dump
+//!
+//! @return 0 if all OK
+//!
+//! @note Elements are dumped only at HIGH_LEVEL, where unused capacity is poisoned
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int StackRender(STACK_TYPE* stack, VarInfo dumpInfo, DumpBuffer* buffer, DumpOptions options);
+
+STACK_TEMPLATE
+void StackRenderText  (STACK_TYPE* stack, VarInfo dumpInfo, DumpBuffer* buffer, DumpOptions options);
+STACK_TEMPLATE
+void StackRenderJson  (STACK_TYPE* stack, VarInfo dumpInfo, DumpBuffer* buffer, DumpOptions options);
+STACK_TEMPLATE
+void StackRenderBinary(STACK_TYPE* stack, VarInfo dumpInfo, DumpBuffer* buffer, DumpOptions options);
+
+STACK_TEMPLATE
+void StackRenderTextElem (STACK_TYPE* stack, DumpBuffer* buffer, int32_t elemIdx);
+STACK_TEMPLATE
+void StackRenderJsonElems(STACK_TYPE* stack, DumpBuffer* buffer, int32_t beginIdx, int32_t endIdx);
+
+//-------------------------------------------------------------------------------------------
+//! Gets shown elements of dump: [0, headEnd) and [tailBegin, size)
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] options Options of dump
+//! @param [out] headEnd Index after the last head element
+//! @param [out] tailBegin Index of the first tail element
 //-------------------------------------------------------------------------------------------
 
-int StackDump(Stack* stack, VarInfo dumpInfo, FILE* outstream = stdout);
+STACK_TEMPLATE
+void GetDumpView(STACK_TYPE* stack, DumpOptions options, int32_t* headEnd, int32_t* tailBegin);
 
 //-------------------------------------------------------------------------------------------
 //! Converts StackError variable to its string representation
@@ -297,19 +1071,69 @@ const char* ErrorToString(StackError error);
 //! @param [in] stack Pointer to the stack which memory will be increased
 //!
 //! @return Pointer to the increased memory area
+//!
+//! @note Capacity is multiplied by policy.increaseMultiplier (at least by one element)
 //-------------------------------------------------------------------------------------------
 
-uint8_t* StackIncrease(Stack* stack);
+STACK_TEMPLATE
+uint8_t* StackIncrease(STACK_TYPE* stack);
 
 //-------------------------------------------------------------------------------------------
-//! Decreases stack memory if values take little space (Lower than DECREASE_MULTIPLIER times)
+//! Decreases stack memory if values take little space (Lower than decreaseThreshold times)
 //!
 //! @param [in] stack Pointer to the stack which memory will be decreased
 //!
 //! @return Pointer to the decreased memory area
+//!
+//! @note Capacity is divided by policy.decreaseMultiplier, but never gets lower than
+//!       policy.minCapacity
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+uint8_t* StackDecrease(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Reallocates stack memory for newCapacity elements
+//!
+//! @param [in] stack Pointer to the stack which memory will be reallocated
+//! @param [in] newCapacity New capacity of stack, must be not lower than size
+//!
+//! @return Pointer to the reallocated memory area
+//!
+//! @note Moves right data canary, poisons new elements and rewrites hashes
 //-------------------------------------------------------------------------------------------
 
-uint8_t* StackDecrease(Stack* stack);
+STACK_TEMPLATE
+uint8_t* StackResize(STACK_TYPE* stack, int32_t newCapacity);
+
+//-------------------------------------------------------------------------------------------
+//! Checks if stack should be decreased after pop
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return true if stack is filled less than policy.decreaseThreshold times
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+bool IsStackTooBig(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Gets current time of monotonic clock
+//!
+//! @return Time in nanoseconds
+//-------------------------------------------------------------------------------------------
+
+uint64_t GetTimeNs();
+
+//-------------------------------------------------------------------------------------------
+//! Gets next pseudo-random value (xorshift)
+//!
+//! @param [in] state Pointer to the generator state, must not be 0
+//!
+//! @return Pseudo-random value
+//-------------------------------------------------------------------------------------------
+
+uint64_t GetRandom(uint64_t* state);
 
 //-------------------------------------------------------------------------------------------
 //! Multiply base to itself power times
@@ -324,4 +1148,95 @@ uint8_t* StackDecrease(Stack* stack);
 
 uint64_t powllu(int32_t base, int32_t power);
 
+//-------------------------------------------------------------------------------------------
+//! Gets bucket of size histogram
+//!
+//! @param [in] size Size of stack
+//!
+//! @return Amount of significant bits in size
+//-------------------------------------------------------------------------------------------
+
+inline uint32_t GetStatsBucket(int32_t size) {
+    return (size > 0) ? 32 - __builtin_clz((uint32_t)size) : 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Adds stats of one stack to stats of its creation place in global registry
+//!
+//! @param [in] creationInfo Place where stack was created
+//! @param [in] stats Pointer to the stats of stack
+//!
+//! @return 0 if no errors, -1 if memory is over
+//!
+//! @note Counters are summed, peakSize is maximum
+//-------------------------------------------------------------------------------------------
+
+int32_t StatsMerge(VarInfo creationInfo, const StackStats* stats);
+
+//-------------------------------------------------------------------------------------------
+//! Gets stats of creation place from global registry
+//!
+//! @param [in] creationInfo Place where stacks were created (file, function and line)
+//! @param [out] site Pointer to the copy of stats
+//!
+//! @return 0 if place is found, -1 otherwise
+//-------------------------------------------------------------------------------------------
+
+int32_t StatsGet(VarInfo creationInfo, StatsSite* site);
+
+//-------------------------------------------------------------------------------------------
+//! Writes stats of all creation places in outstream
+//!
+//! @param [in] outstream Pointer to the stream (default is stdout)
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+int32_t StatsDump(FILE* outstream = stdout);
+
+//-------------------------------------------------------------------------------------------
+//! Removes all creation places from global registry
+//-------------------------------------------------------------------------------------------
+
+void StatsReset();
+
+//-------------------------------------------------------------------------------------------
+//! Gets starting capacity for adaptive stack
+//!
+//! @param [in] creationInfo Place where stack is created
+//!
+//! @return Remembered capacity or 0 if place is unknown
+//-------------------------------------------------------------------------------------------
+
+int32_t GetCapacityHint(VarInfo creationInfo);
+
+//-------------------------------------------------------------------------------------------
+//! Remembers peak size of destroyed adaptive stack
+//!
+//! @param [in] creationInfo Place where stack was created
+//! @param [in] peakSize Peak size of stack
+//!
+//! @return 0 if no errors, -1 if memory is over
+//!
+//! @note Bigger peak is taken at once, smaller one halves the distance to it, so one huge
+//!       stack doesn't make all next ones huge
+//-------------------------------------------------------------------------------------------
+
+int32_t UpdateCapacityHint(VarInfo creationInfo, int32_t peakSize);
+
+//-------------------------------------------------------------------------------------------
+//! Moves stats of stack to global registry, StackDtor does it automatically
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return 0 if no errors
+//!
+//! @note Counters of stack are cleared, so long-living stacks can be merged many times
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackStatsMerge(STACK_TYPE* stack);
+
+#include "stack_impl.h"
+
 #endif
@@ -0,0 +1,258 @@
+#include "stack_alloc.h"
+
+static size_t AlignUp(size_t size) {
+    return (size + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+}
+
+void* MallocAllocate(void* context, size_t size) {
+    (void)context;
+
+    return aligned_alloc(DATA_ALIGNMENT, AlignUp(size));
+}
+
+void* MallocReallocate(void* context, void* pointer, size_t oldSize, size_t newSize) {
+    void* newPointer = realloc(pointer, newSize);
+    if (newPointer == nullptr || (uintptr_t)newPointer % DATA_ALIGNMENT == 0) return newPointer;
+
+    void* alignedPointer = MallocAllocate(context, newSize);
+    if (alignedPointer != nullptr)
+        memcpy(alignedPointer, newPointer, (pointer == nullptr) ? 0 :
+                                           (oldSize < newSize)  ? oldSize : newSize);
+
+    free(newPointer);
+
+    return alignedPointer;
+}
+
+void MallocDeallocate(void* context, void* pointer, size_t size) {
+    (void)context;
+    (void)size;
+
+    free(pointer);
+}
+
+int32_t ArenaCtor(StackArena* arena, size_t chunkSize) {
+    assert(arena     != nullptr && "ARENA_NULL");
+    assert(chunkSize >  0       && "BAD_CHUNK_SIZE");
+
+    arena->chunks        = nullptr;
+    arena->chunkSize     = chunkSize;
+    arena->lastBlock     = nullptr;
+    arena->lastBlockSize = 0;
+
+    return 0;
+}
+
+int32_t ArenaReset(StackArena* arena) {
+    assert(arena != nullptr && "ARENA_NULL");
+
+    if (arena->chunks == nullptr) return 0;
+
+    ArenaChunk* curChunk = arena->chunks->next;
+    while (curChunk != nullptr) {
+        ArenaChunk* nextChunk = curChunk->next;
+        free(curChunk);
+
+        curChunk = nextChunk;
+    }
+
+    arena->chunks->next  = nullptr;
+    arena->chunks->used  = 0;
+    arena->lastBlock     = nullptr;
+    arena->lastBlockSize = 0;
+
+    return 0;
+}
+
+int32_t ArenaDtor(StackArena* arena) {
+    assert(arena != nullptr && "ARENA_NULL");
+
+    ArenaReset(arena);
+    free(arena->chunks);
+
+    arena->chunks = nullptr;
+
+    return 0;
+}
+
+StackAllocator GetArenaAllocator(StackArena* arena) {
+    assert(arena != nullptr && "ARENA_NULL");
+
+    return { ArenaAllocate, ArenaReallocate, ArenaDeallocate, nullptr, arena, false };
+}
+
+void* ArenaAllocate(void* context, size_t size) {
+    StackArena* arena = (StackArena*)context;
+    assert(arena != nullptr && "ARENA_NULL");
+
+    size_t headerSize = AlignUp(sizeof(ArenaChunk));
+    size = AlignUp(size);
+
+    ArenaChunk* chunk = arena->chunks;
+    if (chunk == nullptr || chunk->used + size > chunk->size) {
+        size_t chunkSize = (size > arena->chunkSize) ? size : arena->chunkSize;
+
+        chunk = (ArenaChunk*)MallocAllocate(nullptr, headerSize + chunkSize);
+        if (chunk == nullptr) return nullptr;
+
+        chunk->next   = arena->chunks;
+        chunk->size   = chunkSize;
+        chunk->used   = 0;
+        arena->chunks = chunk;
+    }
+
+    uint8_t* block = (uint8_t*)chunk + headerSize + chunk->used;
+    chunk->used   += size;
+
+    arena->lastBlock     = block;
+    arena->lastBlockSize = size;
+
+    return block;
+}
+
+void* ArenaReallocate(void* context, void* pointer, size_t oldSize, size_t newSize) {
+    StackArena* arena = (StackArena*)context;
+    assert(arena != nullptr && "ARENA_NULL");
+
+    if (pointer == nullptr) return ArenaAllocate(context, newSize);
+
+    ArenaChunk* chunk = arena->chunks;
+    if (pointer == arena->lastBlock &&
+        chunk->used - arena->lastBlockSize + AlignUp(newSize) <= chunk->size) {
+        chunk->used         += AlignUp(newSize) - arena->lastBlockSize;
+        arena->lastBlockSize = AlignUp(newSize);
+
+        return pointer;
+    }
+
+    void* newPointer = ArenaAllocate(context, newSize);
+    if (newPointer == nullptr) return nullptr;
+
+    memcpy(newPointer, pointer, (oldSize < newSize) ? oldSize : newSize);
+
+    return newPointer;
+}
+
+void ArenaDeallocate(void* context, void* pointer, size_t size) {
+    StackArena* arena = (StackArena*)context;
+    assert(arena != nullptr && "ARENA_NULL");
+    (void)size;
+
+    if (pointer != nullptr && pointer == arena->lastBlock) {
+        arena->chunks->used -= arena->lastBlockSize;
+
+        arena->lastBlock     = nullptr;
+        arena->lastBlockSize = 0;
+    }
+}
+
+int32_t PoolCtor(StackPool* pool) {
+    assert(pool != nullptr && "POOL_NULL");
+
+    for (uint32_t curClass = 0; curClass < POOL_CLASSES_COUNT; curClass++) {
+        pool->freeBlocks[curClass] = nullptr;
+    }
+
+    pool->slabs = nullptr;
+
+    return 0;
+}
+
+int32_t PoolDtor(StackPool* pool) {
+    assert(pool != nullptr && "POOL_NULL");
+
+    PoolSlab* curSlab = pool->slabs;
+    while (curSlab != nullptr) {
+        PoolSlab* nextSlab = curSlab->next;
+        free(curSlab);
+
+        curSlab = nextSlab;
+    }
+
+    return PoolCtor(pool);
+}
+
+StackAllocator GetPoolAllocator(StackPool* pool) {
+    assert(pool != nullptr && "POOL_NULL");
+
+    return { PoolAllocate, PoolReallocate, PoolDeallocate, nullptr, pool, false };
+}
+
+uint32_t GetPoolClass(size_t size) {
+    uint32_t curClass = 0;
+
+    while (curClass < POOL_CLASSES_COUNT && ((size_t)1 << (curClass + POOL_MIN_CLASS)) < size) {
+        curClass++;
+    }
+
+    return curClass;
+}
+
+void* PoolAllocate(void* context, size_t size) {
+    StackPool* pool = (StackPool*)context;
+    assert(pool != nullptr && "POOL_NULL");
+
+    uint32_t sizeClass = GetPoolClass(size);
+    if (sizeClass == POOL_CLASSES_COUNT) return MallocAllocate(context, size);
+
+    if (pool->freeBlocks[sizeClass] == nullptr) {
+        size_t headerSize = AlignUp(sizeof(PoolSlab));
+        size_t blockSize  = (size_t)1 << (sizeClass + POOL_MIN_CLASS);
+        size_t slabSize   = (blockSize > POOL_SLAB_SIZE) ? blockSize : POOL_SLAB_SIZE;
+
+        PoolSlab* slab = (PoolSlab*)MallocAllocate(nullptr, headerSize + slabSize);
+        if (slab == nullptr) return nullptr;
+
+        slab->next  = pool->slabs;
+        pool->slabs = slab;
+
+        for (size_t curOffset = slabSize; curOffset >= blockSize; curOffset -= blockSize) {
+            PoolBlock* block = (PoolBlock*)((uint8_t*)slab + headerSize + curOffset - blockSize);
+
+            block->next = pool->freeBlocks[sizeClass];
+            pool->freeBlocks[sizeClass] = block;
+        }
+    }
+
+    PoolBlock* block = pool->freeBlocks[sizeClass];
+    pool->freeBlocks[sizeClass] = block->next;
+
+    return block;
+}
+
+void* PoolReallocate(void* context, void* pointer, size_t oldSize, size_t newSize) {
+    if (pointer == nullptr) return PoolAllocate(context, newSize);
+
+    uint32_t oldClass = GetPoolClass(oldSize);
+    uint32_t newClass = GetPoolClass(newSize);
+
+    if (oldClass == newClass && oldClass != POOL_CLASSES_COUNT) return pointer;
+    if (oldClass == newClass)                                 return MallocReallocate(context, pointer,
+                                                                                    oldSize, newSize);
+
+    void* newPointer = PoolAllocate(context, newSize);
+    if (newPointer == nullptr) return nullptr;
+
+    memcpy(newPointer, pointer, (oldSize < newSize) ? oldSize : newSize);
+    PoolDeallocate(context, pointer, oldSize);
+
+    return newPointer;
+}
+
+void PoolDeallocate(void* context, void* pointer, size_t size) {
+    StackPool* pool = (StackPool*)context;
+    assert(pool != nullptr && "POOL_NULL");
+
+    if (pointer == nullptr) return;
+
+    uint32_t sizeClass = GetPoolClass(size);
+    if (sizeClass == POOL_CLASSES_COUNT) {
+        free(pointer);
+        return;
+    }
+
+    PoolBlock* block = (PoolBlock*)pointer;
+
+    block->next = pool->freeBlocks[sizeClass];
+    pool->freeBlocks[sizeClass] = block;
+}
@@ -0,0 +1,213 @@
+#ifndef _STACK_ALLOC_H_
+#define _STACK_ALLOC_H_
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+const size_t CACHE_LINE_SIZE      = 64;
+
+const size_t ALLOC_ALIGNMENT      = 16;
+const size_t DATA_ALIGNMENT       = CACHE_LINE_SIZE;
+
+const size_t ARENA_CHUNK_SIZE     = 1 << 20;
+
+const uint32_t POOL_MIN_CLASS     = 6;
+const uint32_t POOL_CLASSES_COUNT = 11;
+const size_t POOL_SLAB_SIZE       = 1 << 16;
+
+//-------------------------------------------------------------------------------------------
+//! Memory source of stack data
+//!
+//! @note context is passed to every function, functions get sizes of blocks so allocators
+//!       don't have to store them. Blocks of malloc, arena and pool allocators are aligned by
+//!       DATA_ALIGNMENT, so stack elements after padded protection prefix start at cache line.
+//!       relocate is called when stack structure is moved to other place, it may be nullptr
+//!       if allocator doesn't keep pointers to stacks. isSingleBlock is true if context holds
+//!       only one block at a time, so stack with such allocator can't share it with clone
+//-------------------------------------------------------------------------------------------
+
+struct StackAllocator {
+    void* (*allocate)  (void* context, size_t size);
+    void* (*reallocate)(void* context, void* pointer, size_t oldSize, size_t newSize);
+    void  (*deallocate)(void* context, void* pointer, size_t size);
+    void  (*relocate)  (void* context, const void* oldStack, const void* newStack);
+
+    void* context;
+    bool isSingleBlock;
+};
+
+struct ArenaChunk {
+    ArenaChunk* next;
+
+    size_t size;
+    size_t used;
+};
+
+struct StackArena {
+    ArenaChunk* chunks;
+    size_t chunkSize;
+
+    uint8_t* lastBlock;
+    size_t lastBlockSize;
+};
+
+struct PoolSlab {
+    PoolSlab* next;
+};
+
+struct PoolBlock {
+    PoolBlock* next;
+};
+
+struct StackPool {
+    PoolBlock* freeBlocks[POOL_CLASSES_COUNT];
+    PoolSlab* slabs;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Allocates size bytes with aligned_alloc
+//!
+//! @param [in] context Unused
+//! @param [in] size Amount of bytes
+//!
+//! @return Pointer to the allocated memory aligned by DATA_ALIGNMENT
+//-------------------------------------------------------------------------------------------
+
+void* MallocAllocate(void* context, size_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Reallocates memory with realloc
+//!
+//! @param [in] context Unused
+//! @param [in] pointer Pointer to the memory from MallocAllocate
+//! @param [in] oldSize Current size of memory
+//! @param [in] newSize New size of memory
+//!
+//! @return Pointer to the reallocated memory aligned by DATA_ALIGNMENT
+//!
+//! @note realloc keeps malloc alignment only, so misaligned block is moved once more
+//-------------------------------------------------------------------------------------------
+
+void* MallocReallocate(void* context, void* pointer, size_t oldSize, size_t newSize);
+
+//-------------------------------------------------------------------------------------------
+//! Frees memory with free
+//!
+//! @param [in] context Unused
+//! @param [in] pointer Pointer to the memory from MallocAllocate
+//! @param [in] size Size of memory
+//-------------------------------------------------------------------------------------------
+
+void MallocDeallocate(void* context, void* pointer, size_t size);
+
+const StackAllocator MALLOC_ALLOCATOR = {
+    MallocAllocate,
+    MallocReallocate,
+    MallocDeallocate,
+    nullptr,
+    nullptr,
+    false
+};
+
+//-------------------------------------------------------------------------------------------
+//! Creates bump arena
+//!
+//! @param [in] arena Pointer to the arena which will be created
+//! @param [in] chunkSize Size of memory chunks taken from malloc
+//!
+//! @return 0 if no errors
+//!
+//! @note Arena is not thread-safe
+//-------------------------------------------------------------------------------------------
+
+int32_t ArenaCtor(StackArena* arena, size_t chunkSize = ARENA_CHUNK_SIZE);
+
+//-------------------------------------------------------------------------------------------
+//! Frees all blocks of arena at once, keeps first chunk for next allocations
+//!
+//! @param [in] arena Pointer to the arena
+//!
+//! @return 0 if no errors
+//!
+//! @note Stacks created in arena must not be used after reset, StackDtor is not needed
+//-------------------------------------------------------------------------------------------
+
+int32_t ArenaReset(StackArena* arena);
+
+//-------------------------------------------------------------------------------------------
+//! Destroys arena and returns all its chunks to malloc
+//!
+//! @param [in] arena Pointer to the arena which will be destroyed
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+int32_t ArenaDtor(StackArena* arena);
+
+//-------------------------------------------------------------------------------------------
+//! Makes allocator which takes memory from arena
+//!
+//! @param [in] arena Pointer to the arena
+//!
+//! @return Allocator for StackCtor_
+//!
+//! @note Last allocated block is grown and freed in place, other blocks are freed only by
+//!       ArenaReset
+//-------------------------------------------------------------------------------------------
+
+StackAllocator GetArenaAllocator(StackArena* arena);
+
+void* ArenaAllocate(void* context, size_t size);
+void* ArenaReallocate(void* context, void* pointer, size_t oldSize, size_t newSize);
+void  ArenaDeallocate(void* context, void* pointer, size_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Creates pool of power of two size classes
+//!
+//! @param [in] pool Pointer to the pool which will be created
+//!
+//! @return 0 if no errors
+//!
+//! @note Blocks bigger than the biggest class are taken from malloc. Pool is not thread-safe
+//-------------------------------------------------------------------------------------------
+
+int32_t PoolCtor(StackPool* pool);
+
+//-------------------------------------------------------------------------------------------
+//! Destroys pool and returns all its slabs to malloc
+//!
+//! @param [in] pool Pointer to the pool which will be destroyed
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+int32_t PoolDtor(StackPool* pool);
+
+//-------------------------------------------------------------------------------------------
+//! Makes allocator which takes memory from pool
+//!
+//! @param [in] pool Pointer to the pool
+//!
+//! @return Allocator for StackCtor_
+//-------------------------------------------------------------------------------------------
+
+StackAllocator GetPoolAllocator(StackPool* pool);
+
+void* PoolAllocate(void* context, size_t size);
+void* PoolReallocate(void* context, void* pointer, size_t oldSize, size_t newSize);
+void  PoolDeallocate(void* context, void* pointer, size_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Gets pool size class of block
+//!
+//! @param [in] size Size of block
+//!
+//! @return Index of class, POOL_CLASSES_COUNT if block is too big for pool
+//-------------------------------------------------------------------------------------------
+
+uint32_t GetPoolClass(size_t size);
+
+#endif
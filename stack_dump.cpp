@@ -0,0 +1,128 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stack_dump.h"
+
+int32_t DumpBufferCtor(DumpBuffer* buffer) {
+    assert(buffer != nullptr && "BUFFER_NULL");
+
+    buffer->data     = (char*)calloc(DUMP_BUFFER_BEGINNING_CAPACITY, sizeof(char));
+    buffer->size     = 0;
+    buffer->capacity = (buffer->data != nullptr) ? DUMP_BUFFER_BEGINNING_CAPACITY : 0;
+
+    return 0;
+}
+
+void DumpBufferDtor(DumpBuffer* buffer) {
+    assert(buffer != nullptr && "BUFFER_NULL");
+
+    free(buffer->data);
+
+    buffer->data     = nullptr;
+    buffer->size     = 0;
+    buffer->capacity = 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Makes place for size more bytes in buffer
+//!
+//! @param [in] buffer Pointer to the buffer
+//! @param [in] size Amount of bytes
+//!
+//! @return true if there is place, false if memory is over
+//-------------------------------------------------------------------------------------------
+
+static bool DumpReserve(DumpBuffer* buffer, size_t size) {
+    if (buffer->size + size <= buffer->capacity) return true;
+
+    size_t newCapacity = (buffer->capacity > 0) ? buffer->capacity : DUMP_BUFFER_BEGINNING_CAPACITY;
+    while (newCapacity < buffer->size + size) newCapacity *= 2;
+
+    char* newData = (char*)realloc(buffer->data, newCapacity);
+    if (newData == nullptr) return false;
+
+    buffer->data     = newData;
+    buffer->capacity = newCapacity;
+
+    return true;
+}
+
+void DumpWrite(DumpBuffer* buffer, const void* bytes, size_t size) {
+    assert(buffer != nullptr && "BUFFER_NULL");
+
+    if (!DumpReserve(buffer, size)) return;
+
+    memcpy(buffer->data + buffer->size, bytes, size);
+    buffer->size += size;
+}
+
+void DumpPrintf(DumpBuffer* buffer, const char* format, ...) {
+    assert(buffer != nullptr && "BUFFER_NULL");
+
+    va_list args;
+    va_start(args, format);
+
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+
+    size_t freeSize = buffer->capacity - buffer->size;
+    int    length   = vsnprintf(buffer->data + buffer->size, freeSize, format, args);
+
+    if (length >= 0 && (size_t)length >= freeSize && DumpReserve(buffer, (size_t)length + 1)) {
+        freeSize = buffer->capacity - buffer->size;
+        length   = vsnprintf(buffer->data + buffer->size, freeSize, format, argsCopy);
+    }
+
+    if (length >= 0 && (size_t)length < freeSize) buffer->size += (size_t)length;
+
+    va_end(argsCopy);
+    va_end(args);
+}
+
+void DumpJsonString(DumpBuffer* buffer, const char* string) {
+    if (string == nullptr) {
+        DumpWrite(buffer, "null", 4);
+        return;
+    }
+
+    DumpWrite(buffer, "\"", 1);
+
+    for (const char* curChar = string; *curChar != '\0'; curChar++) {
+        switch (*curChar) {
+            case '"':  DumpWrite(buffer, "\\\"", 2); break;
+            case '\\': DumpWrite(buffer, "\\\\", 2); break;
+            case '\n': DumpWrite(buffer, "\\n",  2); break;
+            case '\t': DumpWrite(buffer, "\\t",  2); break;
+
+            default:
+                if ((unsigned char)*curChar < ' ')
+                    DumpPrintf(buffer, "\\u%04x", (unsigned char)*curChar);
+                else
+                    DumpWrite(buffer, curChar, 1);
+                break;
+        }
+    }
+
+    DumpWrite(buffer, "\"", 1);
+}
+
+int32_t DumpFlush(DumpBuffer* buffer, FILE* outstream) {
+    assert(buffer    != nullptr && "BUFFER_NULL");
+    assert(outstream != nullptr && "STREAM_NULL");
+
+    size_t written = fwrite(buffer->data, sizeof(char), buffer->size, outstream);
+    fflush(outstream);
+
+    bool isWritten = (written == buffer->size);
+    buffer->size   = 0;
+
+    return isWritten ? 0 : -1;
+}
+
+int32_t DumpFinish(DumpBuffer* buffer, FILE* outstream) {
+    int32_t error = DumpFlush(buffer, outstream);
+    DumpBufferDtor(buffer);
+
+    return error;
+}
@@ -0,0 +1,146 @@
+#ifndef _STACK_DUMP_H_
+#define _STACK_DUMP_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+const size_t   DUMP_BUFFER_BEGINNING_CAPACITY = 4096;
+
+const int32_t  DUMP_ALL            = -1;
+const uint32_t DUMP_BINARY_MAGIC   = 0x444B5453;
+const uint16_t DUMP_BINARY_VERSION = 1;
+
+enum DumpFormat {
+    DUMP_TEXT = 0,
+    DUMP_JSON,
+    DUMP_BINARY
+};
+
+//-------------------------------------------------------------------------------------------
+//! What and how dump shows
+//!
+//! @note headCount bottom and tailCount top elements are shown, DUMP_ALL in headCount shows
+//!       all elements and unused capacity one by one like before
+//-------------------------------------------------------------------------------------------
+
+struct DumpOptions {
+    DumpFormat format;
+
+    int32_t headCount;
+    int32_t tailCount;
+};
+
+const DumpOptions DEFAULT_DUMP_OPTIONS = { DUMP_TEXT, DUMP_ALL, DUMP_ALL };
+
+//-------------------------------------------------------------------------------------------
+//! Growing buffer where dump is rendered before it is written in one go
+//-------------------------------------------------------------------------------------------
+
+struct DumpBuffer {
+    char* data;
+
+    size_t size;
+    size_t capacity;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Beginning of binary dump, it is followed by type, stack name, file and function as
+//! zero-terminated strings, then by raw bytes of headCount and tailCount elements
+//-------------------------------------------------------------------------------------------
+
+struct DumpBinaryHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t elemSize;
+
+    int32_t level;
+    int32_t error;
+    int32_t size;
+    int32_t capacity;
+
+    int32_t headCount;
+    int32_t tailCount;
+
+    uint32_t stackCanaries[2];
+    uint32_t dataCanaries[2];
+
+    uint64_t storedStackHash;
+    uint64_t currentStackHash;
+    uint64_t storedDataHash;
+    uint64_t currentDataHash;
+
+    int32_t line;
+    uint32_t stringsSize;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Creates empty dump buffer
+//!
+//! @param [out] buffer Pointer to the buffer
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+int32_t DumpBufferCtor(DumpBuffer* buffer);
+
+//-------------------------------------------------------------------------------------------
+//! Frees memory of dump buffer
+//!
+//! @param [in] buffer Pointer to the buffer
+//-------------------------------------------------------------------------------------------
+
+void DumpBufferDtor(DumpBuffer* buffer);
+
+//-------------------------------------------------------------------------------------------
+//! Appends bytes to dump buffer
+//!
+//! @param [in] buffer Pointer to the buffer
+//! @param [in] bytes Pointer to the bytes
+//! @param [in] size Amount of bytes
+//-------------------------------------------------------------------------------------------
+
+void DumpWrite(DumpBuffer* buffer, const void* bytes, size_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Appends formatted string to dump buffer like printf
+//!
+//! @param [in] buffer Pointer to the buffer
+//! @param [in] format Format string
+//-------------------------------------------------------------------------------------------
+
+void DumpPrintf(DumpBuffer* buffer, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+//-------------------------------------------------------------------------------------------
+//! Appends string to dump buffer as JSON string with quotes
+//!
+//! @param [in] buffer Pointer to the buffer
+//! @param [in] string Zero-terminated string, nullptr is written as null
+//-------------------------------------------------------------------------------------------
+
+void DumpJsonString(DumpBuffer* buffer, const char* string);
+
+//-------------------------------------------------------------------------------------------
+//! Writes whole buffer in outstream with one fwrite and empties buffer
+//!
+//! @param [in] buffer Pointer to the buffer
+//! @param [in] outstream Pointer to the stream, its buffering isn't changed
+//!
+//! @return 0 if all bytes are written
+//-------------------------------------------------------------------------------------------
+
+int32_t DumpFlush(DumpBuffer* buffer, FILE* outstream);
+
+//-------------------------------------------------------------------------------------------
+//! Writes whole buffer in outstream and frees it
+//!
+//! @param [in] buffer Pointer to the buffer
+//! @param [in] outstream Pointer to the stream
+//!
+//! @return 0 if all bytes are written
+//-------------------------------------------------------------------------------------------
+
+int32_t DumpFinish(DumpBuffer* buffer, FILE* outstream);
+
+#endif
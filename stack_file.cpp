@@ -0,0 +1,121 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "stack_file.h"
+
+StackAllocator GetFileAllocator(StackFile* file) {
+    assert(file != nullptr && "FILE_NULL");
+
+    return { FileAllocate, FileReallocate, FileDeallocate, nullptr, file, true };
+}
+
+//-------------------------------------------------------------------------------------------
+//! Changes size of file and its mapping
+//!
+//! @param [in] file Pointer to the file
+//! @param [in] newMapSize New size of file
+//!
+//! @return 0 if no errors, -1 if file can't be resized
+//-------------------------------------------------------------------------------------------
+
+static int32_t FileResize(StackFile* file, size_t newMapSize) {
+    if (newMapSize > file->mapSize && ftruncate(file->fd, (off_t)newMapSize) != 0) return -1;
+
+    void* newMap = MAP_FAILED;
+
+    if (file->map == nullptr) {
+        newMap = mmap(nullptr, newMapSize, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+    }
+    else {
+        #ifdef __linux__
+            newMap = mremap(file->map, file->mapSize, newMapSize, MREMAP_MAYMOVE);
+        #else
+            munmap(file->map, file->mapSize);
+            newMap = mmap(nullptr, newMapSize, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+        #endif
+    }
+
+    if (newMap == MAP_FAILED) return -1;
+
+    if (newMapSize < file->mapSize && ftruncate(file->fd, (off_t)newMapSize) != 0) return -1;
+
+    file->map     = (uint8_t*)newMap;
+    file->mapSize = newMapSize;
+
+    return 0;
+}
+
+void* FileAllocate(void* context, size_t size) {
+    StackFile* file = (StackFile*)context;
+    assert(file != nullptr && "FILE_NULL");
+    assert(file->fd >= 0 && "FILE_CLOSED");
+
+    if (FileResize(file, FILE_HEADER_SIZE + size) != 0) return nullptr;
+
+    return file->map + FILE_HEADER_SIZE;
+}
+
+void* FileReallocate(void* context, void* pointer, size_t oldSize, size_t newSize) {
+    StackFile* file = (StackFile*)context;
+    assert(file != nullptr && "FILE_NULL");
+    (void)oldSize;
+
+    if (pointer == nullptr) return FileAllocate(context, newSize);
+    assert(pointer == file->map + FILE_HEADER_SIZE && "FOREIGN_POINTER");
+
+    if (FileResize(file, FILE_HEADER_SIZE + newSize) != 0) return nullptr;
+
+    return file->map + FILE_HEADER_SIZE;
+}
+
+void FileDeallocate(void* context, void* pointer, size_t size) {
+    StackFile* file = (StackFile*)context;
+    assert(file != nullptr && "FILE_NULL");
+    (void)pointer;
+    (void)size;
+
+    if (file->map != nullptr) munmap(file->map, file->mapSize);
+    if (file->fd  >= 0)       close(file->fd);
+
+    file->fd      = -1;
+    file->map     = nullptr;
+    file->mapSize = 0;
+}
+
+int32_t FileMap(StackFile* file, const char* path, bool isNew) {
+    assert(file != nullptr && "FILE_NULL");
+    assert(path != nullptr && "PATH_NULL");
+
+    file->map     = nullptr;
+    file->mapSize = 0;
+    file->fd      = open(path, isNew ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+    if (file->fd < 0) return -1;
+
+    if (isNew) return 0;
+
+    struct stat fileStat = {};
+    if (fstat(file->fd, &fileStat) != 0 || (size_t)fileStat.st_size < FILE_HEADER_SIZE ||
+        FileResize(file, (size_t)fileStat.st_size) != 0) {
+        FileDeallocate(file, nullptr, 0);
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t FileSync(StackFile* file) {
+    assert(file != nullptr && "FILE_NULL");
+
+    if (file->map == nullptr) return 0;
+
+    return msync(file->map, file->mapSize, MS_SYNC);
+}
+
+StackFileHeader* GetFileHeader(StackFile* file) {
+    assert(file      != nullptr && "FILE_NULL");
+    assert(file->map != nullptr && "FILE_NOT_MAPPED");
+
+    return (StackFileHeader*)file->map;
+}
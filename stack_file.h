@@ -0,0 +1,172 @@
+#ifndef _STACK_FILE_H_
+#define _STACK_FILE_H_
+
+#include "stack.h"
+
+#define StackFileCreate(stack, type, file, path)                  \
+    Stack<type> stack = {};                                       \
+    StackFileCreate_(&stack, file, path LOCATION (stack));
+
+#define StackFileOpen(stack, type, file, path)                    \
+    Stack<type> stack = {};                                       \
+    StackFileOpen_(&stack, file, path LOCATION (stack));
+
+const uint64_t FILE_MAGIC       = 0x4B43415453454C46;
+const uint32_t FILE_VERSION     = 2;
+const size_t   FILE_HEADER_SIZE = 64;
+
+//-------------------------------------------------------------------------------------------
+//! Header in the beginning of stack file, data block with its canaries and hashes follows it
+//!
+//! @note headerHash is hash of all fields before it
+//-------------------------------------------------------------------------------------------
+
+struct StackFileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t elemSize;
+
+    int32_t level;
+    int32_t hashType;
+    int32_t size;
+    int32_t capacity;
+
+    hashValue headerHash;
+};
+
+static_assert(sizeof(StackFileHeader) <= FILE_HEADER_SIZE, "Header doesn't fit its place");
+
+//-------------------------------------------------------------------------------------------
+//! Mapped stack file, it is context of file allocator
+//-------------------------------------------------------------------------------------------
+
+struct StackFile {
+    int fd;
+
+    uint8_t* map;
+    size_t mapSize;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Makes allocator which keeps data in mapped file
+//!
+//! @param [in] file Pointer to the file with opened fd
+//!
+//! @return Allocator for StackCtor_
+//!
+//! @note Data grows and shrinks with ftruncate and mremap, deallocate unmaps and closes file,
+//!       but file stays on disk. File holds one stack only, so clone of stack in file is
+//!       created in malloc memory
+//-------------------------------------------------------------------------------------------
+
+StackAllocator GetFileAllocator(StackFile* file);
+
+void* FileAllocate(void* context, size_t size);
+void* FileReallocate(void* context, void* pointer, size_t oldSize, size_t newSize);
+void  FileDeallocate(void* context, void* pointer, size_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Opens file and maps it whole
+//!
+//! @param [out] file Pointer to the file
+//! @param [in]  path Path to the file
+//! @param [in]  isNew true if file must be created or truncated
+//!
+//! @return 0 if no errors, -1 if file can't be opened or mapped
+//-------------------------------------------------------------------------------------------
+
+int32_t FileMap(StackFile* file, const char* path, bool isNew);
+
+//-------------------------------------------------------------------------------------------
+//! Writes mapped pages to disk
+//!
+//! @param [in] file Pointer to the file
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+int32_t FileSync(StackFile* file);
+
+//-------------------------------------------------------------------------------------------
+//! Gets header of mapped stack file
+//!
+//! @param [in] file Pointer to the file
+//!
+//! @return Pointer to the header
+//-------------------------------------------------------------------------------------------
+
+StackFileHeader* GetFileHeader(StackFile* file);
+
+//-------------------------------------------------------------------------------------------
+//! Creates stack in new file from StackFileCreate macro
+//!
+//! @param [in] stack Pointer to the stack structure which will be created
+//! @param [in] file Pointer to the file structure, it must live as long as stack
+//! @param [in] path Path to the file, existing file is truncated
+//! @param [in] policy Growth policy of stack
+//!
+//! @return 0 if no errors, FILE_INVALID if file can't be created
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackFileCreate_(STACK_TYPE* stack, StackFile* file, const char* path, VarInfo creationInfo,
+                         GrowthPolicy policy = DEFAULT_GROWTH_POLICY);
+
+//-------------------------------------------------------------------------------------------
+//! Opens stack saved in file from StackFileOpen macro
+//!
+//! @param [in] stack Pointer to the stack structure which will be opened
+//! @param [in] file Pointer to the file structure, it must live as long as stack
+//! @param [in] path Path to the file
+//! @param [in] policy Growth policy of stack
+//!
+//! @return 0 if stack is valid, FILE_INVALID if header doesn't match stack type or
+//!         other StackError of data check
+//!
+//! @note Data is mapped, not read, it is validated with IsAllOk and full data hash
+//!       before use
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackFileOpen_(STACK_TYPE* stack, StackFile* file, const char* path, VarInfo creationInfo,
+                       GrowthPolicy policy = DEFAULT_GROWTH_POLICY);
+
+//-------------------------------------------------------------------------------------------
+//! Writes size and capacity in file header and flushes mapped pages to disk
+//!
+//! @param [in] stack Pointer to the stack in file
+//!
+//! @return 0 if no errors
+//!
+//! @note File can be reopened only in state of the last sync
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackFileSync(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Syncs stack and destroys it, file stays on disk
+//!
+//! @param [in] stack Pointer to the stack in file
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackFileClose(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Gets hash of stack file header
+//!
+//! @param [in] header Pointer to the header
+//!
+//! @return Hash of fields before headerHash
+//-------------------------------------------------------------------------------------------
+
+inline hashValue GetFileHeaderHash(StackFileHeader* header) {
+    return GetHash((uint8_t*)header, (uint8_t*)&header->headerHash - (uint8_t*)header);
+}
+
+#include "stack_file_impl.h"
+
+#endif
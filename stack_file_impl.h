@@ -0,0 +1,122 @@
+#ifndef _STACK_FILE_IMPL_H_
+#define _STACK_FILE_IMPL_H_
+
+STACK_TEMPLATE
+int32_t StackFileCreate_(STACK_TYPE* stack, StackFile* file, const char* path, VarInfo creationInfo,
+                         GrowthPolicy policy) {
+    static_assert(InlineCapacity == 0, "Stack in file can't be inline");
+    assert(stack != nullptr && "STACK_NULL");
+    assert(file  != nullptr && "FILE_NULL");
+
+    if (FileMap(file, path, true) != 0) return FILE_INVALID;
+
+    int level = (Level == DYNAMIC_LEVEL) ? STACK_DEBUG : Level;
+    StackCtor_(stack, creationInfo, policy, level, GetFileAllocator(file));
+
+    return StackFileSync(stack);
+}
+
+STACK_TEMPLATE
+int32_t StackFileOpen_(STACK_TYPE* stack, StackFile* file, const char* path, VarInfo creationInfo,
+                       GrowthPolicy policy) {
+    static_assert(InlineCapacity == 0, "Stack in file can't be inline");
+    assert(stack != nullptr && "STACK_NULL");
+    assert(file  != nullptr && "FILE_NULL");
+
+    if (FileMap(file, path, false) != 0) return FILE_INVALID;
+
+    StackFileHeader* header = GetFileHeader(file);
+
+    bool isHeaderOk = header->magic    == FILE_MAGIC   &&
+                      header->version  == FILE_VERSION &&
+                      header->elemSize == sizeof(T)    &&
+                      header->hashType == STACK_HASH   &&
+                      header->headerHash == GetFileHeaderHash(header);
+
+    isHeaderOk = isHeaderOk && header->level >= LOW_LEVEL && header->level <= HIGH_LEVEL &&
+                 (Level == DYNAMIC_LEVEL || header->level == Level);
+
+    isHeaderOk = isHeaderOk && header->capacity >= header->size && header->size >= 0 &&
+                 file->mapSize == FILE_HEADER_SIZE + GetProtectionSize(header->level) +
+                                  (uint64_t)header->capacity * sizeof(T);
+
+    if (!isHeaderOk) {
+        FileDeallocate(file, nullptr, 0);
+        return FILE_INVALID;
+    }
+
+    stack->level        = header->level;
+    stack->policy       = policy;
+    stack->verifyPolicy = DEFAULT_VERIFY_POLICY;
+    stack->allocator    = GetFileAllocator(file);
+
+    stack->verifyState.randomState = (uint64_t)(uintptr_t)stack | 1;
+    stack->verifyState.startTime   = GetTimeNs();
+    stack->capacity     = header->capacity;
+    stack->size         = header->size;
+    stack->peakSize     = header->size;
+
+    stack->creationInfo = creationInfo;
+    stack->data         = file->map + FILE_HEADER_SIZE + StackShift(stack);
+
+    if (StackLevel(stack) >= MID_LEVEL) {
+        stack->canaryLeft  = CANARY;
+        stack->canaryRight = CANARY;
+    }
+
+    StackError error = NO_ERROR;
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        // Stack hash covers pointers of this process, so only data hash from file is checked
+        if (!error) error = IsCanariesOk(stack);
+        if (!error) error = IsDataHashOk(stack);
+        if (!error) error = IsPoisonOk(stack);
+
+        ResetDirtyHash(stack);
+        WriteStackHash(stack);
+    }
+
+    if (!error) error = IsAllOk(stack);
+
+    if (error) {
+        FileDeallocate(file, nullptr, 0);
+        stack->data = (uint8_t*)FREE_VALUE + StackShift(stack);
+        stack->size = -1;
+    }
+
+    return error;
+}
+
+STACK_TEMPLATE
+int32_t StackFileSync(STACK_TYPE* stack) {
+    CheckStack(stack, IsAllOk);
+
+    StackFile* file = (StackFile*)stack->allocator.context;
+    assert(stack->allocator.allocate == FileAllocate && "STACK_NOT_IN_FILE");
+
+    StackFileHeader* header = GetFileHeader(file);
+
+    header->magic      = FILE_MAGIC;
+    header->version    = FILE_VERSION;
+    header->elemSize   = sizeof(T);
+    header->level      = StackLevel(stack);
+    header->hashType   = STACK_HASH;
+    header->size       = stack->size;
+    header->capacity   = stack->capacity;
+    header->headerHash = GetFileHeaderHash(header);
+
+    if (FileSync(file) != 0) return FILE_INVALID;
+
+    return 0;
+}
+
+STACK_TEMPLATE
+int32_t StackFileClose(STACK_TYPE* stack) {
+    int32_t error = StackFileSync(stack);
+
+    StackDtor(stack);
+
+    return error;
+}
+
+#endif
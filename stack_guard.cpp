@@ -0,0 +1,220 @@
+#include <atomic>
+#include <mutex>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "stack_guard.h"
+
+struct GuardRegistry {
+    std::atomic<bool> isBusy[GUARD_REGISTRY_SIZE];
+    GuardEntry entries[GUARD_REGISTRY_SIZE];
+
+    struct sigaction oldAction;
+
+    std::mutex mutex;
+};
+
+static GuardRegistry GUARD_REGISTRY;
+
+static size_t GetPageSize() {
+    static size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+
+    return pageSize;
+}
+
+static size_t AlignUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Gets start of mapping with guard pages of block
+//!
+//! @param [in] pointer Pointer to the block from GuardAllocate
+//! @param [in] size Size of block
+//!
+//! @return Pointer to the left guard page
+//-------------------------------------------------------------------------------------------
+
+static uint8_t* GetGuardBase(const void* pointer, size_t size) {
+    size_t pageSize = GetPageSize();
+
+    uint8_t* rightGuard = (uint8_t*)pointer + AlignUp(size, ALLOC_ALIGNMENT);
+
+    return rightGuard - AlignUp(size, pageSize) - pageSize;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Unmaps block with its guard pages, registry is not changed
+//!
+//! @param [in] pointer Pointer to the block from GuardAllocate
+//! @param [in] size Size of block
+//-------------------------------------------------------------------------------------------
+
+static void GuardUnmap(void* pointer, size_t size) {
+    munmap(GetGuardBase(pointer, size), AlignUp(size, GetPageSize()) + 2 * GetPageSize());
+}
+
+void* GuardAllocate(void* context, size_t size) {
+    (void)context;
+
+    size_t pageSize  = GetPageSize();
+    size_t dataSize  = AlignUp(size, pageSize);
+
+    uint8_t* base = (uint8_t*)mmap(nullptr, dataSize + 2 * pageSize, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return nullptr;
+
+    uint8_t* rightGuard = base + pageSize + dataSize;
+
+    if (mprotect(base,       pageSize, PROT_NONE) != 0 ||
+        mprotect(rightGuard, pageSize, PROT_NONE) != 0) {
+        munmap(base, dataSize + 2 * pageSize);
+        return nullptr;
+    }
+
+    return rightGuard - AlignUp(size, ALLOC_ALIGNMENT);
+}
+
+void* GuardReallocate(void* context, void* pointer, size_t oldSize, size_t newSize) {
+    if (pointer == nullptr) return GuardAllocate(context, newSize);
+
+    void* newPointer = GuardAllocate(context, newSize);
+    if (newPointer == nullptr) return nullptr;
+
+    memcpy(newPointer, pointer, (oldSize < newSize) ? oldSize : newSize);
+    GuardUnmap(pointer, oldSize);
+
+    return newPointer;
+}
+
+void GuardDeallocate(void* context, void* pointer, size_t size) {
+    (void)context;
+    if (pointer == nullptr) return;
+
+    // Stack which owns block is removed, so destroyed stack can't be dumped by handler
+    uintptr_t leftGuard = (uintptr_t)GetGuardBase(pointer, size);
+
+    {
+        std::lock_guard<std::mutex> lock(GUARD_REGISTRY.mutex);
+
+        for (uint32_t curEntry = 0; curEntry < GUARD_REGISTRY_SIZE; curEntry++) {
+            if (!GUARD_REGISTRY.isBusy[curEntry].load(std::memory_order_relaxed)) continue;
+
+            GuardEntry* entry = &GUARD_REGISTRY.entries[curEntry];
+            if (entry->isGuardHit(entry->stack, leftGuard))
+                GUARD_REGISTRY.isBusy[curEntry].store(false, std::memory_order_release);
+        }
+    }
+
+    GuardUnmap(pointer, size);
+}
+
+void GuardRelocate(void* context, const void* oldStack, const void* newStack) {
+    (void)context;
+
+    std::lock_guard<std::mutex> lock(GUARD_REGISTRY.mutex);
+
+    for (uint32_t curEntry = 0; curEntry < GUARD_REGISTRY_SIZE; curEntry++) {
+        if (GUARD_REGISTRY.isBusy[curEntry].load(std::memory_order_relaxed) &&
+            GUARD_REGISTRY.entries[curEntry].stack == oldStack) {
+            GUARD_REGISTRY.isBusy[curEntry].store(false, std::memory_order_release);
+            GUARD_REGISTRY.entries[curEntry].stack = newStack;
+            GUARD_REGISTRY.isBusy[curEntry].store(true,  std::memory_order_release);
+        }
+    }
+}
+
+bool IsGuardPage(const void* pointer, size_t size, uintptr_t address) {
+    size_t pageSize = GetPageSize();
+
+    uintptr_t leftGuard  = (uintptr_t)GetGuardBase(pointer, size);
+    uintptr_t rightGuard = leftGuard + pageSize + AlignUp(size, pageSize);
+
+    return (address >= leftGuard  && address < leftGuard  + pageSize) ||
+           (address >= rightGuard && address < rightGuard + pageSize);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Dumps stack which guard page was hit and lets the fault happen again with old handler
+//!
+//! @note StackDump isn't async-signal-safe, but process is going to die anyway
+//-------------------------------------------------------------------------------------------
+
+static void GuardHandler(int signal, siginfo_t* info, void* context) {
+    uintptr_t address = (uintptr_t)info->si_addr;
+
+    for (uint32_t curEntry = 0; curEntry < GUARD_REGISTRY_SIZE; curEntry++) {
+        if (!GUARD_REGISTRY.isBusy[curEntry].load(std::memory_order_acquire)) continue;
+
+        GuardEntry* entry = &GUARD_REGISTRY.entries[curEntry];
+        if (entry->isGuardHit(entry->stack, address)) {
+            fprintf(stderr, "Guard page of stack was hit at %p\n", info->si_addr);
+            entry->dump(entry->stack);
+            break;
+        }
+    }
+
+    if (GUARD_REGISTRY.oldAction.sa_flags & SA_SIGINFO) {
+        if (GUARD_REGISTRY.oldAction.sa_sigaction != nullptr) {
+            GUARD_REGISTRY.oldAction.sa_sigaction(signal, info, context);
+            return;
+        }
+    }
+    else if (GUARD_REGISTRY.oldAction.sa_handler != SIG_DFL &&
+             GUARD_REGISTRY.oldAction.sa_handler != SIG_IGN) {
+        GUARD_REGISTRY.oldAction.sa_handler(signal);
+        return;
+    }
+
+    sigaction(SIGSEGV, &GUARD_REGISTRY.oldAction, nullptr);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Installs GuardHandler once
+//-------------------------------------------------------------------------------------------
+
+static void GuardInstallHandler() {
+    static bool isInstalled = [] {
+        struct sigaction action = {};
+
+        action.sa_sigaction = GuardHandler;
+        action.sa_flags     = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+
+        return sigaction(SIGSEGV, &action, &GUARD_REGISTRY.oldAction) == 0;
+    }();
+
+    assert(isInstalled && "SIGACTION_ERR");
+    (void)isInstalled;
+}
+
+int32_t GuardRegister(GuardEntry entry) {
+    assert(entry.stack != nullptr && "STACK_NULL");
+
+    GuardInstallHandler();
+
+    std::lock_guard<std::mutex> lock(GUARD_REGISTRY.mutex);
+
+    for (uint32_t curEntry = 0; curEntry < GUARD_REGISTRY_SIZE; curEntry++) {
+        if (GUARD_REGISTRY.isBusy[curEntry].load(std::memory_order_relaxed)) continue;
+
+        GUARD_REGISTRY.entries[curEntry] = entry;
+        GUARD_REGISTRY.isBusy[curEntry].store(true, std::memory_order_release);
+
+        return 0;
+    }
+
+    return -1;
+}
+
+void GuardUnregister(const void* stack) {
+    std::lock_guard<std::mutex> lock(GUARD_REGISTRY.mutex);
+
+    for (uint32_t curEntry = 0; curEntry < GUARD_REGISTRY_SIZE; curEntry++) {
+        if (GUARD_REGISTRY.isBusy[curEntry].load(std::memory_order_relaxed) &&
+            GUARD_REGISTRY.entries[curEntry].stack == stack) {
+            GUARD_REGISTRY.isBusy[curEntry].store(false, std::memory_order_release);
+        }
+    }
+}
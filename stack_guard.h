@@ -0,0 +1,149 @@
+#ifndef _STACK_GUARD_H_
+#define _STACK_GUARD_H_
+
+#include "stack.h"
+
+#define StackCtorGuard(stack, type, level)                                 \
+    Stack<type, level> stack = {};                                         \
+    StackCtor_(&stack LOCATION (stack), DEFAULT_GROWTH_POLICY, level, GUARD_ALLOCATOR); \
+    GuardStackRegister(&stack);
+
+const uint32_t GUARD_REGISTRY_SIZE = 64;
+
+//-------------------------------------------------------------------------------------------
+//! Guarded stack in registry of SIGSEGV handler
+//!
+//! @note Functions know type of stack, so handler can work with stacks of any type
+//-------------------------------------------------------------------------------------------
+
+struct GuardEntry {
+    const void* stack;
+
+    bool (*isGuardHit)(const void* stack, uintptr_t address);
+    void (*dump)      (const void* stack);
+};
+
+//-------------------------------------------------------------------------------------------
+//! Maps block between two PROT_NONE guard pages, end of block touches the right guard page
+//!
+//! @param [in] context Unused
+//! @param [in] size Amount of bytes
+//!
+//! @return Pointer to the block
+//!
+//! @note Start of block is aligned by ALLOC_ALIGNMENT, so up to ALLOC_ALIGNMENT - 1 bytes
+//!       after block can be written without fault
+//-------------------------------------------------------------------------------------------
+
+void* GuardAllocate(void* context, size_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Maps new guarded block and moves memory there
+//!
+//! @param [in] context Unused
+//! @param [in] pointer Pointer to the block from GuardAllocate
+//! @param [in] oldSize Current size of block
+//! @param [in] newSize New size of block
+//!
+//! @return Pointer to the new block
+//-------------------------------------------------------------------------------------------
+
+void* GuardReallocate(void* context, void* pointer, size_t oldSize, size_t newSize);
+
+//-------------------------------------------------------------------------------------------
+//! Unmaps block with its guard pages and removes stack which owns it from registry
+//!
+//! @param [in] context Unused
+//! @param [in] pointer Pointer to the block from GuardAllocate
+//! @param [in] size Size of block
+//!
+//! @note So StackDtor of registered stack doesn't leave dangling entry
+//-------------------------------------------------------------------------------------------
+
+void GuardDeallocate(void* context, void* pointer, size_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Moves registry entry of stack to its new place
+//!
+//! @param [in] context Unused
+//! @param [in] oldStack Pointer to the old place of stack
+//! @param [in] newStack Pointer to the new place of stack
+//!
+//! @note Called by StackRelocate, so moved and swapped stacks stay registered
+//-------------------------------------------------------------------------------------------
+
+void GuardRelocate(void* context, const void* oldStack, const void* newStack);
+
+//-------------------------------------------------------------------------------------------
+//! Allocator of guarded blocks, overruns fault in hardware without per-operation checks
+//!
+//! @note With LOW_LEVEL stack it replaces software canaries, with higher levels it
+//!       works together with them
+//-------------------------------------------------------------------------------------------
+
+const StackAllocator GUARD_ALLOCATOR = {
+    GuardAllocate,
+    GuardReallocate,
+    GuardDeallocate,
+    GuardRelocate,
+    nullptr,
+    false
+};
+
+//-------------------------------------------------------------------------------------------
+//! Checks if address is in one of guard pages of block
+//!
+//! @param [in] pointer Pointer to the block from GuardAllocate
+//! @param [in] size Size of block
+//! @param [in] address Checked address
+//!
+//! @return true if address is in guard page
+//-------------------------------------------------------------------------------------------
+
+bool IsGuardPage(const void* pointer, size_t size, uintptr_t address);
+
+//-------------------------------------------------------------------------------------------
+//! Adds stack to registry and installs SIGSEGV handler on first call
+//!
+//! @param [in] entry Entry of stack
+//!
+//! @return 0 if no errors, -1 if registry is full
+//-------------------------------------------------------------------------------------------
+
+int32_t GuardRegister(GuardEntry entry);
+
+//-------------------------------------------------------------------------------------------
+//! Removes stack from registry
+//!
+//! @param [in] stack Pointer to the stack
+//-------------------------------------------------------------------------------------------
+
+void GuardUnregister(const void* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Registers stack with guarded data, fault in its guard pages prints StackDump to stderr
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return 0 if no errors, -1 if registry is full
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t GuardStackRegister(STACK_TYPE* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Removes stack from registry and destroys it
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return 0 if no errors
+//!
+//! @note StackDtor removes guarded stack too, this one also removes inline stack
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackGuardDtor(STACK_TYPE* stack);
+
+#include "stack_guard_impl.h"
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef _STACK_GUARD_IMPL_H_
+#define _STACK_GUARD_IMPL_H_
+
+STACK_TEMPLATE
+bool IsGuardStackHit(const void* guardedStack, uintptr_t address) {
+    const STACK_TYPE* stack = (const STACK_TYPE*)guardedStack;
+
+    if (stack->allocator.allocate != GuardAllocate) return false;
+    if (IsStackInline(stack))                      return false;
+
+    return IsGuardPage(stack->data - StackShift(stack),
+                       stack->capacity * sizeof(T) + StackProtectionSize(stack), address);
+}
+
+STACK_TEMPLATE
+void GuardStackDump(const void* guardedStack) {
+    STACK_TYPE* stack = (STACK_TYPE*)guardedStack;
+
+    StackDump(stack LOCATION (guard page), stderr);
+}
+
+STACK_TEMPLATE
+int32_t GuardStackRegister(STACK_TYPE* stack) {
+    CheckStack(stack, IsAllOk);
+
+    return GuardRegister({ stack, IsGuardStackHit<T, Level, InlineCapacity>,
+                                  GuardStackDump <T, Level, InlineCapacity> });
+}
+
+STACK_TEMPLATE
+int32_t StackGuardDtor(STACK_TYPE* stack) {
+    GuardUnregister(stack);
+
+    return StackDtor(stack);
+}
+
+#endif
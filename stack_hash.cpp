@@ -0,0 +1,210 @@
+#include "stack_hash.h"
+
+#if defined(__x86_64__)
+    #include <immintrin.h>
+#endif
+
+static inline uint64_t RotateLeft(uint64_t value, uint32_t shift) {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+static inline uint64_t ReadWord(const uint8_t* pointer) {
+    uint64_t word = 0;
+    memcpy(&word, pointer, sizeof(word));
+
+    return word;
+}
+
+static inline uint64_t XxRound(uint64_t accumulator, uint64_t input) {
+    accumulator += input * XXH_PRIME_2;
+    accumulator  = RotateLeft(accumulator, 31);
+
+    return accumulator * XXH_PRIME_1;
+}
+
+static inline uint64_t XxMergeRound(uint64_t hash, uint64_t accumulator) {
+    hash ^= XxRound(0, accumulator);
+
+    return hash * XXH_PRIME_1 + XXH_PRIME_4;
+}
+
+uint64_t GetXxHash(const uint8_t* pointer, uint64_t size, uint64_t seed) {
+    const uint8_t* end = pointer + size;
+    uint64_t hash      = 0;
+
+    if (size >= XXH_STRIPE) {
+        uint64_t accumulators[4] = { seed + XXH_PRIME_1 + XXH_PRIME_2, seed + XXH_PRIME_2,
+                                     seed,                             seed - XXH_PRIME_1 };
+
+        for (; pointer + XXH_STRIPE <= end; pointer += XXH_STRIPE) {
+            for (uint32_t curLane = 0; curLane < 4; curLane++) {
+                accumulators[curLane] = XxRound(accumulators[curLane],
+                                                ReadWord(pointer + curLane * sizeof(uint64_t)));
+            }
+        }
+
+        hash = RotateLeft(accumulators[0], 1)  + RotateLeft(accumulators[1], 7) +
+               RotateLeft(accumulators[2], 12) + RotateLeft(accumulators[3], 18);
+
+        for (uint32_t curLane = 0; curLane < 4; curLane++) {
+            hash = XxMergeRound(hash, accumulators[curLane]);
+        }
+    }
+    else {
+        hash = seed + XXH_PRIME_5;
+    }
+
+    hash += size;
+
+    for (; pointer + sizeof(uint64_t) <= end; pointer += sizeof(uint64_t)) {
+        hash ^= XxRound(0, ReadWord(pointer));
+        hash  = RotateLeft(hash, 27) * XXH_PRIME_1 + XXH_PRIME_4;
+    }
+
+    if (pointer + sizeof(uint32_t) <= end) {
+        uint32_t halfWord = 0;
+        memcpy(&halfWord, pointer, sizeof(halfWord));
+
+        hash    ^= halfWord * XXH_PRIME_1;
+        hash     = RotateLeft(hash, 23) * XXH_PRIME_2 + XXH_PRIME_3;
+        pointer += sizeof(uint32_t);
+    }
+
+    for (; pointer < end; pointer++) {
+        hash ^= *pointer * XXH_PRIME_5;
+        hash  = RotateLeft(hash, 11) * XXH_PRIME_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+struct Crc32cTable {
+    uint32_t values[256];
+};
+
+//-------------------------------------------------------------------------------------------
+//! Makes table of CRC32C for every byte
+//!
+//! @return Table
+//-------------------------------------------------------------------------------------------
+
+static Crc32cTable MakeCrc32cTable() {
+    Crc32cTable table = {};
+
+    for (uint32_t curByte = 0; curByte < 256; curByte++) {
+        uint32_t crc = curByte;
+
+        for (uint32_t curBit = 0; curBit < 8; curBit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+        }
+
+        table.values[curByte] = crc;
+    }
+
+    return table;
+}
+
+static const uint32_t* GetCrc32cByteTable() {
+    static const Crc32cTable table = MakeCrc32cTable();
+
+    return table.values;
+}
+
+uint32_t GetCrc32cTable(const uint8_t* pointer, uint64_t size, uint32_t crc) {
+    const uint32_t* table = GetCrc32cByteTable();
+
+    crc = ~crc;
+    for (uint64_t curByte = 0; curByte < size; curByte++) {
+        crc = table[(crc ^ pointer[curByte]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+uint32_t GetCrc32cWordTable(uint64_t word, uint32_t crc) {
+    uint8_t bytes[sizeof(uint64_t)] = {};
+    memcpy(bytes, &word, sizeof(word));
+
+    return GetCrc32cTable(bytes, sizeof(bytes), crc);
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("sse4.2")))
+uint32_t GetCrc32cSse42(const uint8_t* pointer, uint64_t size, uint32_t crc) {
+    uint64_t wideCrc = ~crc;
+
+    uint64_t curByte = 0;
+    for (; curByte + sizeof(uint64_t) <= size; curByte += sizeof(uint64_t)) {
+        wideCrc = _mm_crc32_u64(wideCrc, ReadWord(pointer + curByte));
+    }
+
+    uint32_t narrowCrc = (uint32_t)wideCrc;
+    for (; curByte < size; curByte++) {
+        narrowCrc = _mm_crc32_u8(narrowCrc, pointer[curByte]);
+    }
+
+    return ~narrowCrc;
+}
+
+__attribute__((target("sse4.2")))
+uint32_t GetCrc32cWordSse42(uint64_t word, uint32_t crc) {
+    return ~(uint32_t)_mm_crc32_u64(~crc, word);
+}
+
+__attribute__((target("sse4.2")))
+uint32_t GetCrc32cWordsHashSse42(const uint8_t* data, uint64_t beginWord, uint64_t endWord) {
+    uint32_t hashSum = 0;
+    for (uint64_t curWord = beginWord; curWord < endWord; curWord++) {
+        uint32_t seed = (uint32_t)((curWord * HASH_WORD_MULTIPLIER) >> 32);
+
+        hashSum += ~(uint32_t)_mm_crc32_u64(~seed, ReadWord(data + curWord * sizeof(uint64_t)));
+    }
+
+    return hashSum;
+}
+
+static bool IsSse42Supported() {
+    static bool isSupported = __builtin_cpu_supports("sse4.2");
+
+    return isSupported;
+}
+
+#endif
+
+uint32_t GetCrc32c(const uint8_t* pointer, uint64_t size, uint32_t crc) {
+    #if defined(__x86_64__)
+        if (IsSse42Supported()) return GetCrc32cSse42(pointer, size, crc);
+    #endif
+
+    return GetCrc32cTable(pointer, size, crc);
+}
+
+uint32_t GetCrc32cWord(uint64_t word, uint32_t crc) {
+    #if defined(__x86_64__)
+        if (IsSse42Supported()) return GetCrc32cWordSse42(word, crc);
+    #endif
+
+    return GetCrc32cWordTable(word, crc);
+}
+
+uint32_t GetCrc32cWordsHash(const uint8_t* data, uint64_t beginWord, uint64_t endWord) {
+    #if defined(__x86_64__)
+        if (IsSse42Supported()) return GetCrc32cWordsHashSse42(data, beginWord, endWord);
+    #endif
+
+    uint32_t hashSum = 0;
+    for (uint64_t curWord = beginWord; curWord < endWord; curWord++) {
+        uint32_t seed = (uint32_t)((curWord * HASH_WORD_MULTIPLIER) >> 32);
+
+        hashSum += GetCrc32cWordTable(ReadWord(data + curWord * sizeof(uint64_t)), seed);
+    }
+
+    return hashSum;
+}
@@ -0,0 +1,74 @@
+#ifndef _STACK_HASH_H_
+#define _STACK_HASH_H_
+
+#include "stack.h"
+
+const uint64_t XXH_PRIME_1 = 0x9E3779B185EBCA87;
+const uint64_t XXH_PRIME_2 = 0xC2B2AE3D27D4EB4F;
+const uint64_t XXH_PRIME_3 = 0x165667B19E3779F9;
+const uint64_t XXH_PRIME_4 = 0x85EBCA77C2B2AE63;
+const uint64_t XXH_PRIME_5 = 0x27D4EB2F165667C5;
+
+const uint32_t XXH_STRIPE  = 32;
+
+const uint32_t CRC32C_POLY = 0x82F63B78;
+
+//-------------------------------------------------------------------------------------------
+//! 64-bit xxHash (XXH64) of bytes
+//!
+//! @param [in] pointer Pointer to the bytes
+//! @param [in] size Amount of bytes
+//! @param [in] seed Seed of hash
+//!
+//! @return Hash
+//-------------------------------------------------------------------------------------------
+
+uint64_t GetXxHash(const uint8_t* pointer, uint64_t size, uint64_t seed);
+
+//-------------------------------------------------------------------------------------------
+//! CRC32C (Castagnoli) of bytes
+//!
+//! @param [in] pointer Pointer to the bytes
+//! @param [in] size Amount of bytes
+//! @param [in] crc Initial value
+//!
+//! @return CRC
+//!
+//! @note Uses SSE4.2 crc32 instruction if CPU supports it, table otherwise
+//-------------------------------------------------------------------------------------------
+
+uint32_t GetCrc32c(const uint8_t* pointer, uint64_t size, uint32_t crc);
+
+//-------------------------------------------------------------------------------------------
+//! CRC32C of one 8-byte word
+//!
+//! @param [in] word Value of word
+//! @param [in] crc Initial value
+//!
+//! @return CRC
+//-------------------------------------------------------------------------------------------
+
+uint32_t GetCrc32cWord(uint64_t word, uint32_t crc);
+
+//-------------------------------------------------------------------------------------------
+//! Sum of GetWordHash of full words in [beginWord, endWord) for CRC32C_HASH
+//!
+//! @param [in] data Pointer to the words
+//! @param [in] beginWord Index of the first word
+//! @param [in] endWord Index after the last word
+//!
+//! @return Sum of word CRCs
+//-------------------------------------------------------------------------------------------
+
+uint32_t GetCrc32cWordsHash(const uint8_t* data, uint64_t beginWord, uint64_t endWord);
+
+uint32_t GetCrc32cTable   (const uint8_t* pointer, uint64_t size, uint32_t crc);
+uint32_t GetCrc32cWordTable(uint64_t word, uint32_t crc);
+
+#if defined(__x86_64__)
+uint32_t GetCrc32cSse42    (const uint8_t* pointer, uint64_t size, uint32_t crc);
+uint32_t GetCrc32cWordSse42(uint64_t word, uint32_t crc);
+uint32_t GetCrc32cWordsHashSse42(const uint8_t* data, uint64_t beginWord, uint64_t endWord);
+#endif
+
+#endif
@@ -0,0 +1,1095 @@
+#ifndef _STACK_IMPL_H_
+#define _STACK_IMPL_H_
+
+STACK_TEMPLATE
+int32_t StackCtor_(STACK_TYPE* stack, VarInfo creationInfo, GrowthPolicy policy, int level,
+                   StackAllocator allocator) {
+    return StackCtor_(stack, creationInfo, 0, policy, level, allocator);
+}
+
+STACK_TEMPLATE
+int32_t StackCtor_(STACK_TYPE* stack, VarInfo creationInfo, int32_t capacity, GrowthPolicy policy,
+                   int level, StackAllocator allocator) {
+    assert(stack != nullptr && "STACK_NULL");
+    assert(capacity >= 0    && "CAPACITY_NEGATIVE");
+
+    assert(level >= LOW_LEVEL && level <= HIGH_LEVEL          && "LEVEL_INVALID");
+    assert((Level == DYNAMIC_LEVEL || level == Level)         && "LEVEL_INVALID");
+
+    assert(policy.minCapacity        >  0                          && "BAD_POLICY");
+    assert(policy.increaseMultiplier >  1                          && "BAD_POLICY");
+    assert(policy.decreaseMultiplier >  1                          && "BAD_POLICY");
+    assert(policy.decreaseThreshold  >  policy.increaseMultiplier  && "BAD_POLICY");
+    assert(policy.decreaseThreshold  >  policy.decreaseMultiplier  && "BAD_POLICY");
+
+    stack->level        = level;
+    stack->policy       = policy;
+    stack->verifyPolicy = DEFAULT_VERIFY_POLICY;
+    stack->allocator    = allocator;
+
+    stack->verifyState.randomState = (uint64_t)(uintptr_t)stack | 1;
+    stack->verifyState.startTime   = GetTimeNs();
+    if (capacity == 0) {
+        capacity = (InlineCapacity > 0) ? InlineCapacity : policy.minCapacity;
+
+        if (policy.isAdaptive) {
+            int32_t capacityHint = GetCapacityHint(creationInfo);
+            if (capacityHint > capacity) capacity = capacityHint;
+        }
+    }
+
+    bool isInline       = (InlineCapacity > 0 && capacity <= InlineCapacity);
+
+    stack->capacity     = isInline ? InlineCapacity : capacity;
+    stack->size         = 0;
+    stack->peakSize     = 0;
+
+    stack->creationInfo = creationInfo;
+    StatsAdd(stack, stacks, 1);
+
+    uint64_t sizeOfData           = stack->capacity * sizeof(T);
+    uint64_t sizeOfAllData        = sizeOfData + StackProtectionSize(stack);
+
+    if (isInline)
+        stack->data = stack->inlineData;
+    else
+        stack->data = (uint8_t*)allocator.allocate(allocator.context, sizeOfAllData);
+    assert(stack->data != nullptr && "DATA_NULL");
+	stack->data += StackShift(stack);
+
+    if (StackLevel(stack) >= MID_LEVEL) {
+        stack->canaryLeft         = CANARY;
+        stack->canaryRight        = CANARY;
+
+        uint8_t* endOfData        = stack->data + sizeOfData;
+
+        *(canary*)(stack->data - StackShift(stack))   = CANARY;
+        *(canary*)(endOfData)             = CANARY;
+    }
+
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        StackFillPoison(stack, 0, stack->capacity);
+
+        WriteAllStackHash(stack);
+    }
+
+    return 0;
+}
+
+STACK_TEMPLATE
+int32_t StackDtor(STACK_TYPE* stack) {
+    CheckStack(stack, IsAllOk);
+    StackStatsMerge(stack);
+
+    if (stack->policy.isAdaptive)
+        UpdateCapacityHint(stack->creationInfo, stack->peakSize);
+
+    // data stays valid during deallocate, so allocator can still find stack by its block
+    uint8_t* storage = stack->data - StackShift(stack);
+
+    if (storage != stack->inlineData)
+        stack->allocator.deallocate(stack->allocator.context, storage,
+                                    stack->capacity * sizeof(T) + StackProtectionSize(stack));
+    stack->data  = (uint8_t*)FREE_VALUE + StackShift(stack);
+    stack->size  = -1;
+
+    return 0;
+}
+
+STACK_TEMPLATE
+int32_t StackPush(STACK_TYPE* stack, typename STACK_TYPE::Elem pushedValue) {
+    CheckAllStack(stack);
+
+    if (stack->size >= stack->capacity)
+        stack->data  = StackIncrease(stack);
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        if (stack->verifyState.isVerified)
+            ResetDirtyHash(stack);
+        RemoveElemsFromHash(stack, stack->size, stack->size + 1);
+    }
+
+    *(T*)(stack->data + (stack->size) * sizeof(T)) = pushedValue;
+    stack->size++;
+
+    if (stack->size > stack->peakSize) stack->peakSize = stack->size;
+
+    StatsAdd(stack, pushes, 1);
+    StatsMax(stack, peakSize, stack->size);
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        AddElemsToHash(stack, stack->size - 1, stack->size);
+        WriteStackHash(stack);
+    }
+
+    CheckAllStack(stack);
+    return 0;
+}
+
+STACK_TEMPLATE
+T StackPop(STACK_TYPE* stack) {
+    CheckAllStack(stack);
+
+    assert(stack->size  != 0 && "STACK_UNDERFLOW");
+
+    StatsAdd(stack, pops, 1);
+    StatsAdd(stack, popSizes[GetStatsBucket(stack->size)], 1);
+
+    --stack->size;
+    T poppedValue = *(T*)(stack->data + stack->size * sizeof(T));
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        if (stack->verifyState.isVerified)
+            ResetDirtyHash(stack);
+        RemoveElemsFromHash(stack, stack->size, stack->size + 1);
+    }
+
+    *(T*)(stack->data + stack->size * sizeof(T)) = StackElemInfo<T>::Poison();
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        AddElemsToHash(stack, stack->size, stack->size + 1);
+        WriteStackHash(stack);
+    }
+
+    if (IsStackTooBig(stack))
+        stack->data      = StackDecrease(stack);
+
+    CheckAllStack(stack);
+    return poppedValue;
+}
+
+STACK_TEMPLATE
+int32_t StackPushN(STACK_TYPE* stack, const T* pushedValues, int32_t count) {
+    CheckAllStack(stack);
+
+    assert(count >= 0 && "NEGATIVE_COUNT");
+    assert((pushedValues != nullptr || count == 0) && "VALUES_NULL");
+
+    if (stack->size + count > stack->capacity) {
+        int32_t newCapacity = (int32_t)(stack->capacity * stack->policy.increaseMultiplier);
+        if (newCapacity < stack->size + count) newCapacity = stack->size + count;
+
+        stack->data = StackResize(stack, newCapacity);
+    }
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        if (stack->verifyState.isVerified)
+            ResetDirtyHash(stack);
+        RemoveElemsFromHash(stack, stack->size, stack->size + count);
+    }
+
+    memcpy(stack->data + stack->size * sizeof(T), pushedValues, count * sizeof(T));
+    stack->size += count;
+
+    if (stack->size > stack->peakSize) stack->peakSize = stack->size;
+
+    StatsAdd(stack, pushes, count);
+    StatsMax(stack, peakSize, stack->size);
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        AddElemsToHash(stack, stack->size - count, stack->size);
+        WriteStackHash(stack);
+    }
+
+    CheckAllStack(stack);
+    return 0;
+}
+
+STACK_TEMPLATE
+int32_t StackPopN(STACK_TYPE* stack, T* poppedValues, int32_t count) {
+    CheckAllStack(stack);
+
+    assert(count >= 0 && "NEGATIVE_COUNT");
+    assert((poppedValues != nullptr || count == 0) && "VALUES_NULL");
+    assert(stack->size  >= count && "STACK_UNDERFLOW");
+
+    StatsAdd(stack, pops, count);
+    StatsAdd(stack, popSizes[GetStatsBucket(stack->size)], count);
+
+    stack->size -= count;
+    T* poppedBegin = (T*)(stack->data + stack->size * sizeof(T));
+    memcpy(poppedValues, poppedBegin, count * sizeof(T));
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        if (stack->verifyState.isVerified)
+            ResetDirtyHash(stack);
+        RemoveElemsFromHash(stack, stack->size, stack->size + count);
+    }
+
+    StackFillPoison(stack, stack->size, stack->size + count);
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        AddElemsToHash(stack, stack->size, stack->size + count);
+        WriteStackHash(stack);
+    }
+
+    if (IsStackTooBig(stack)) {
+        int32_t newCapacity = stack->capacity;
+        while (newCapacity > stack->policy.minCapacity &&
+               stack->size * stack->policy.decreaseThreshold <= newCapacity) {
+            newCapacity = (int32_t)(newCapacity / stack->policy.decreaseMultiplier);
+        }
+
+        if (newCapacity < stack->policy.minCapacity) newCapacity = stack->policy.minCapacity;
+        if (newCapacity < stack->size)              newCapacity = stack->size;
+
+        stack->data = StackResize(stack, newCapacity);
+    }
+
+    CheckAllStack(stack);
+    return 0;
+}
+
+STACK_TEMPLATE
+inline void StackPushFast(STACK_TYPE* stack, typename STACK_TYPE::Elem pushedValue) {
+    assert(stack->verifyState.scopeDepth > 0 && "NOT_IN_SCOPE");
+
+    if (stack->size >= stack->capacity)
+        stack->data = StackIncrease(stack);
+
+    *(T*)(stack->data + stack->size * sizeof(T)) = pushedValue;
+    stack->size++;
+
+    if (stack->size > stack->peakSize) stack->peakSize = stack->size;
+
+    StatsAdd(stack, pushes, 1);
+}
+
+STACK_TEMPLATE
+inline T StackPopFast(STACK_TYPE* stack) {
+    assert(stack->verifyState.scopeDepth > 0 && "NOT_IN_SCOPE");
+    assert(stack->size != 0 && "STACK_UNDERFLOW");
+
+    StatsAdd(stack, pops, 1);
+
+    --stack->size;
+    T* poppedLocation = (T*)(stack->data + stack->size * sizeof(T));
+    T  poppedValue    = *poppedLocation;
+
+    *poppedLocation   = StackElemInfo<T>::Poison();
+
+    return poppedValue;
+}
+
+STACK_TEMPLATE
+StackVerifyScope<T, Level, InlineCapacity>::StackVerifyScope(STACK_TYPE* stack) : stack(stack) {
+    if (stack->verifyState.scopeDepth == 0) {
+        CheckStack(stack, IsAllOk);
+    }
+
+    stack->verifyState.scopeDepth++;
+}
+
+STACK_TEMPLATE
+StackVerifyScope<T, Level, InlineCapacity>::~StackVerifyScope() {
+    assert(stack->verifyState.scopeDepth > 0 && "NOT_IN_SCOPE");
+
+    if (--stack->verifyState.scopeDepth > 0) return;
+
+    if (StackLevel(stack) >= HIGH_LEVEL)
+        WriteAllStackHash(stack);
+
+    if (IsStackTooBig(stack))
+        stack->data = StackDecrease(stack);
+
+    CheckStack(stack, IsAllOk);
+}
+
+STACK_TEMPLATE
+STACK_TYPE::Stack(Stack&& other) {
+    CheckAllStack(&other);
+
+    StackRelocate(this, &other);
+}
+
+STACK_TEMPLATE
+STACK_TYPE& STACK_TYPE::operator=(Stack&& other) {
+    if (this == &other) return *this;
+
+    CheckAllStack(&other);
+
+    if (data != nullptr && !IsDataOk(this))
+        StackDtor(this);
+
+    StackRelocate(this, &other);
+
+    return *this;
+}
+
+STACK_TEMPLATE
+void StackRelocate(STACK_TYPE* dest, STACK_TYPE* source) {
+    bool isInline = IsStackInline(source);
+
+    memcpy((void*)dest, (const void*)source, sizeof(STACK_TYPE));
+
+    if (isInline)
+        dest->data = dest->inlineData + StackShift(dest);
+
+    if (StackLevel(dest) >= HIGH_LEVEL)
+        WriteStackHash(dest);
+
+    if (dest->allocator.relocate != nullptr)
+        dest->allocator.relocate(dest->allocator.context, source, dest);
+
+    source->data  = (uint8_t*)FREE_VALUE;
+    source->size  = -1;
+
+    source->data += StackShift(source);
+}
+
+STACK_TEMPLATE
+int32_t StackSwap(STACK_TYPE* first, STACK_TYPE* second) {
+    CheckAllStack(first);
+    CheckAllStack(second);
+
+    if (first == second) return 0;
+
+    STACK_TYPE temp;
+
+    StackRelocate(&temp,  first);
+    StackRelocate(first,  second);
+    StackRelocate(second, &temp);
+
+    return 0;
+}
+
+STACK_TEMPLATE
+int32_t StackClone_(STACK_TYPE* clone, STACK_TYPE* source, VarInfo creationInfo, StackAllocator allocator) {
+    CheckAllStack(source);
+
+    int32_t capacity = (source->size > source->policy.minCapacity) ? source->size :
+                                                                     source->policy.minCapacity;
+
+    if (allocator.isSingleBlock && allocator.context == source->allocator.context)
+        allocator = MALLOC_ALLOCATOR;
+
+    StackCtor_(clone, creationInfo, capacity, source->policy, StackLevel(source), allocator);
+    StackPushN(clone, (const T*)source->data, source->size);
+
+    return 0;
+}
+
+STACK_TEMPLATE
+int32_t StackReserve(STACK_TYPE* stack, int32_t capacity) {
+    CheckAllStack(stack);
+
+    assert(capacity >= 0 && "CAPACITY_NEGATIVE");
+
+    if (capacity > stack->capacity)
+        stack->data = StackResize(stack, capacity);
+
+    if (capacity > stack->policy.minCapacity) {
+        stack->policy.minCapacity = capacity;
+
+        if (StackLevel(stack) >= HIGH_LEVEL)
+            WriteStackHash(stack);
+    }
+
+    CheckAllStack(stack);
+    return 0;
+}
+
+STACK_TEMPLATE
+int32_t StackShrinkToFit(STACK_TYPE* stack) {
+    CheckAllStack(stack);
+
+    if (IsStackInline(stack)) return 0;
+
+    int32_t newCapacity = (stack->size > 0) ? stack->size : 1;
+
+    if (newCapacity < stack->policy.minCapacity) {
+        stack->policy.minCapacity = newCapacity;
+
+        if (StackLevel(stack) >= HIGH_LEVEL)
+            WriteStackHash(stack);
+    }
+
+    if (newCapacity != stack->capacity)
+        stack->data = StackResize(stack, newCapacity);
+
+    CheckAllStack(stack);
+    return 0;
+}
+
+STACK_TEMPLATE
+StackError IsStackOk(STACK_TYPE* stack) {
+    if (stack == nullptr)                               return STACK_NULL;
+    if (StackLevel(stack) < LOW_LEVEL ||
+        StackLevel(stack) > HIGH_LEVEL)                 return LEVEL_INVALID;
+
+    return NO_ERROR;
+}
+
+STACK_TEMPLATE
+StackError IsDataOk(STACK_TYPE* stack) {
+    if (stack->data - StackShift(stack) == nullptr)                 return  DATA_NULL;
+    if (stack->data - StackShift(stack) == (uint8_t*)FREE_VALUE)    return STACK_FREE;
+
+    return NO_ERROR;
+}
+
+STACK_TEMPLATE
+StackError IsCapacityOk(STACK_TYPE* stack) {
+    if (stack->capacity < 0)             return CAPACITY_NEGATIVE;
+    if (!isfinite(stack->capacity))      return CAPACITY_INFINITE;
+
+    return NO_ERROR;
+}
+
+STACK_TEMPLATE
+StackError IsSizeOk(STACK_TYPE* stack) {
+    if (stack->size > stack->capacity)   return STACK_OVERFLOW;
+    if (stack->size < 0)                 return STACK_UNDERFLOW;
+
+    return NO_ERROR;
+}
+
+STACK_TEMPLATE
+StackError IsCanariesOk(STACK_TYPE* stack) {
+    if (stack->canaryLeft  != CANARY)                   return LEFT_STACK_CANARY_IRRUPTION;
+    if (stack->canaryRight != CANARY)                   return RIGHT_STACK_CANARY_IRRUPTION;
+
+    uint64_t sizeOfData = stack->capacity * sizeof(T);
+    if (*(canary*)(stack->data - StackShift(stack))      != CANARY) return LEFT_DATA_CANARY_IRRUPTION;
+    if (*(canary*)(stack->data + sizeOfData) != CANARY) return RIGHT_DATA_CANARY_IRRUPTION;
+
+    return NO_ERROR;
+}
+
+STACK_TEMPLATE
+StackError IsHashesOk(STACK_TYPE* stack) {
+    uint64_t checkBegin      = StatsNow();
+
+    hashValue stackHash      = *(hashValue*)(stack->data - 2 * sizeof(hashValue));
+    hashValue dataHash       = *(hashValue*)(stack->data - sizeof(hashValue));
+
+    StackError error         = NO_ERROR;
+
+    #if (STACK_HASH_CHECK == DIRTY_HASH_CHECK)
+        uint64_t sizeOfData  = stack->capacity * sizeof(T);
+        hashValue dirtyHash  = GetWordsHash(stack->data, sizeOfData, stack->dirtyBegin, stack->dirtyEnd);
+
+        if (stack->cleanHash + dirtyHash != dataHash) error = DATA_HASH_IRRUPTION;
+    #else
+        if (GetDataHash(stack)  != dataHash)  error = DATA_HASH_IRRUPTION;
+    #endif
+
+    if (GetStackHash(stack) != stackHash) error = STACK_HASH_IRRUPTION;
+
+    StatsAdd(stack, hashChecks, 1);
+    StatsAdd(stack, hashTime,   StatsNow() - checkBegin);
+
+    return error;
+}
+
+STACK_TEMPLATE
+StackError IsDataHashOk(STACK_TYPE* stack) {
+    uint64_t checkBegin      = StatsNow();
+
+    hashValue dataHash       = *(hashValue*)(stack->data - sizeof(hashValue));
+    bool isDataHashOk        = (GetDataHash(stack) == dataHash);
+
+    StatsAdd(stack, hashChecks, 1);
+    StatsAdd(stack, hashTime,   StatsNow() - checkBegin);
+
+    return isDataHashOk ? NO_ERROR : DATA_HASH_IRRUPTION;
+}
+
+STACK_TEMPLATE
+StackError IsPoisonOk(STACK_TYPE* stack) {
+    if (StackLevel(stack) < HIGH_LEVEL) return NO_ERROR;
+
+    T poison = StackElemInfo<T>::Poison();
+    if (!IsPatternFilled(stack->data + stack->size * sizeof(T), &poison, sizeof(T),
+                         stack->capacity - stack->size))
+        return POISON_IRRUPTION;
+
+    return NO_ERROR;
+}
+
+STACK_TEMPLATE
+StackError IsAllOk(STACK_TYPE* stack) {
+    if (StackError error =  IsStackOk(stack))    return error;
+    if (StackError error =  IsDataOk(stack))     return error;
+    if (StackError error =  IsCapacityOk(stack)) return error;
+    if (StackError error =  IsSizeOk(stack))     return error;
+
+    if (StackLevel(stack) >= MID_LEVEL) {
+        if (StackError error =  IsCanariesOk(stack)) return error;
+    }
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        if (StackError error =  IsHashesOk(stack))   return error;
+    }
+
+    return NO_ERROR;
+}
+
+STACK_TEMPLATE
+StackError IsAllOkScheduled(STACK_TYPE* stack) {
+    if (stack == nullptr)                                       return STACK_NULL;
+
+    VerifyState* state = &stack->verifyState;
+    if (state->scopeDepth > 0)                                  return NO_ERROR;
+
+    state->counter++;
+
+    switch (stack->verifyPolicy.mode) {
+        case VERIFY_ALWAYS:
+            break;
+
+        case VERIFY_EVERY_NTH:
+            if (state->counter % stack->verifyPolicy.period != 0)    return NO_ERROR;
+            break;
+
+        case VERIFY_RANDOM:
+            if (GetRandom(&state->randomState) >
+                stack->verifyPolicy.probability * (float)UINT64_MAX) return NO_ERROR;
+            break;
+
+        case VERIFY_TIME_BUDGET: {
+            uint64_t curTime = GetTimeNs();
+
+            if (state->checkTime >
+                stack->verifyPolicy.budgetShare * (curTime - state->startTime)) return NO_ERROR;
+
+            StackError error  = IsAllOk(stack);
+            uint64_t checkTime = GetTimeNs() - curTime;
+            state->checkTime += checkTime;
+            state->isVerified = (error == NO_ERROR);
+
+            StatsAdd(stack, checks,    1);
+            StatsAdd(stack, checkTime, checkTime);
+
+            return error;
+        }
+
+        default:
+            break;
+    }
+
+    uint64_t checkBegin = StatsNow();
+
+    StackError error  = IsAllOk(stack);
+    state->isVerified = (error == NO_ERROR);
+
+    StatsAdd(stack, checks,    1);
+    StatsAdd(stack, checkTime, StatsNow() - checkBegin);
+
+    return error;
+}
+
+STACK_TEMPLATE
+int32_t StackSetVerifyPolicy(STACK_TYPE* stack, VerifyPolicy verifyPolicy) {
+    CheckStack(stack, IsAllOk);
+
+    assert(verifyPolicy.mode   >= VERIFY_ALWAYS &&
+           verifyPolicy.mode   <= VERIFY_TIME_BUDGET && "BAD_POLICY");
+    assert(verifyPolicy.period >  0                  && "BAD_POLICY");
+
+    stack->verifyPolicy = verifyPolicy;
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        WriteStackHash(stack);
+    }
+
+    return 0;
+}
+
+STACK_TEMPLATE
+hashValue GetStackHash(STACK_TYPE* stack) {
+    uint32_t sizeOfStack = (uint32_t)((uint8_t*)&stack->canaryRight - (uint8_t*)stack) - sizeof(canary);
+
+    return GetHash((uint8_t*)stack + sizeof(canary), sizeOfStack);
+}
+
+STACK_TEMPLATE
+hashValue GetDataHash(STACK_TYPE* stack) {
+    uint64_t sizeOfData  = stack->capacity * sizeof(T);
+
+    return GetWordsHash(stack->data, sizeOfData, 0, UINT64_MAX);
+}
+
+STACK_TEMPLATE
+void WriteAllStackHash(STACK_TYPE* stack) {
+    hashValue* dataHashLocation  = (hashValue*)(stack->data - sizeof(hashValue));
+    *dataHashLocation  = GetDataHash(stack);
+
+    ResetDirtyHash(stack);
+    WriteStackHash(stack);
+}
+
+STACK_TEMPLATE
+void WriteStackHash(STACK_TYPE* stack) {
+    hashValue* stackHashLocation = (hashValue*)(stack->data - 2 * sizeof(hashValue));
+    *stackHashLocation = GetStackHash(stack);
+}
+
+STACK_TEMPLATE
+void RemoveElemsFromHash(STACK_TYPE* stack, int32_t beginIdx, int32_t endIdx) {
+    uint64_t sizeOfData = stack->capacity * sizeof(T);
+    uint64_t beginWord  =  beginIdx * sizeof(T) / sizeof(uint64_t);
+    uint64_t endWord    = (endIdx   * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    hashValue* dataHashLocation = (hashValue*)(stack->data - sizeof(hashValue));
+    *dataHashLocation -= GetWordsHash(stack->data, sizeOfData, beginWord, endWord);
+
+    stack->verifyState.isVerified = false;
+
+    #if (STACK_HASH_CHECK == DIRTY_HASH_CHECK)
+        if (stack->dirtyBegin == stack->dirtyEnd) {
+            stack->dirtyBegin = beginWord;
+            stack->dirtyEnd   = beginWord;
+        }
+
+        if (beginWord < stack->dirtyBegin) {
+            stack->cleanHash -= GetWordsHash(stack->data, sizeOfData, beginWord, stack->dirtyBegin);
+            stack->dirtyBegin = beginWord;
+        }
+
+        if (endWord > stack->dirtyEnd) {
+            stack->cleanHash -= GetWordsHash(stack->data, sizeOfData, stack->dirtyEnd, endWord);
+            stack->dirtyEnd   = endWord;
+        }
+    #endif
+}
+
+STACK_TEMPLATE
+void ResetDirtyHash(STACK_TYPE* stack) {
+    #if (STACK_HASH_CHECK == DIRTY_HASH_CHECK)
+        stack->cleanHash  = *(hashValue*)(stack->data - sizeof(hashValue));
+        stack->dirtyBegin = 0;
+        stack->dirtyEnd   = 0;
+    #else
+        (void)stack;
+    #endif
+}
+
+STACK_TEMPLATE
+void AddElemsToHash(STACK_TYPE* stack, int32_t beginIdx, int32_t endIdx) {
+    uint64_t sizeOfData = stack->capacity * sizeof(T);
+    uint64_t beginWord  =  beginIdx * sizeof(T) / sizeof(uint64_t);
+    uint64_t endWord    = (endIdx   * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    hashValue* dataHashLocation = (hashValue*)(stack->data - sizeof(hashValue));
+    *dataHashLocation += GetWordsHash(stack->data, sizeOfData, beginWord, endWord);
+}
+
+STACK_TEMPLATE
+void StackFillPoison(STACK_TYPE* stack, int32_t beginIdx, int32_t endIdx) {
+    if (beginIdx >= endIdx) return;
+
+    T poison = StackElemInfo<T>::Poison();
+
+    FillPattern(stack->data + beginIdx * sizeof(T), &poison, sizeof(T), endIdx - beginIdx);
+}
+
+STACK_TEMPLATE
+int StackDump(STACK_TYPE* stack, VarInfo dumpInfo, FILE* outstream, DumpOptions options) {
+    DumpBuffer buffer = {};
+    DumpBufferCtor(&buffer);
+
+    StackRender(stack, dumpInfo, &buffer, options);
+
+    return DumpFinish(&buffer, outstream);
+}
+
+STACK_TEMPLATE
+int StackRender(STACK_TYPE* stack, VarInfo dumpInfo, DumpBuffer* buffer, DumpOptions options) {
+    switch (options.format) {
+        case DUMP_TEXT:
+            StackRenderText  (stack, dumpInfo, buffer, options);
+            break;
+
+        case DUMP_JSON:
+            StackRenderJson  (stack, dumpInfo, buffer, options);
+            break;
+
+        case DUMP_BINARY:
+            StackRenderBinary(stack, dumpInfo, buffer, options);
+            break;
+
+        default:
+            assert(!"BAD_FORMAT");
+            break;
+    }
+
+    return 0;
+}
+
+STACK_TEMPLATE
+void GetDumpView(STACK_TYPE* stack, DumpOptions options, int32_t* headEnd, int32_t* tailBegin) {
+    int32_t size = (stack->size > 0) ? stack->size : 0;
+
+    if (options.headCount == DUMP_ALL) {
+        *headEnd   = size;
+        *tailBegin = size;
+
+        return;
+    }
+
+    *headEnd   = (options.headCount < size) ? options.headCount : size;
+    *tailBegin = (options.tailCount < size - *headEnd) ? size - options.tailCount : *headEnd;
+}
+
+STACK_TEMPLATE
+void StackRenderTextElem(STACK_TYPE* stack, DumpBuffer* buffer, int32_t elemIdx) {
+    T  poison     = StackElemInfo<T>::Poison();
+    T* curElement = (T*)(stack->data + elemIdx * sizeof(T));
+    bool isPoison = (memcmp(curElement, &poison, sizeof(T)) == 0);
+
+    if (elemIdx < stack->size) {
+        DumpPrintf(buffer, "   *[%d][%p] = ", elemIdx, curElement);
+        StackElemInfo<T>::Print(buffer, *curElement);
+        DumpPrintf(buffer, " (%s)\n", isPoison ? "MAYBE POISON" : "Ok");
+    }
+    else {
+        DumpPrintf(buffer, "   [%d][%p] = ", elemIdx, curElement);
+        StackElemInfo<T>::Print(buffer, *curElement);
+        DumpPrintf(buffer, " (%s)\n", isPoison ? "Poison" : "NOT POISON, BUT SHOULD BE");
+    }
+}
+
+STACK_TEMPLATE
+void StackRenderText(STACK_TYPE* stack, VarInfo dumpInfo, DumpBuffer* buffer, DumpOptions options) {
+    DumpPrintf(buffer, "Dump from %s() at %s(%d) in stack called now \"%s\": IsStackOk() FAILED\n",
+               dumpInfo.function, dumpInfo.file, dumpInfo.line, dumpInfo.name);
+
+    DumpPrintf(buffer, "stack <%s> [%p] (ok) \"%s\" ",
+               StackElemInfo<T>::NAME, stack, stack->creationInfo.name);
+    DumpPrintf(buffer, "from %s (%d), %s(): {\n",
+               stack->creationInfo.file,  stack->creationInfo.line, stack->creationInfo.function);
+
+    DumpPrintf(buffer, "level    = %d (%s)\n",
+               StackLevel(stack), ErrorToString(IsStackOk(stack)));
+    DumpPrintf(buffer, "checks   = %llu (%llu ns, mode %d)\n",
+               (unsigned long long)stack->verifyState.counter,
+               (unsigned long long)stack->verifyState.checkTime, stack->verifyPolicy.mode);
+    DumpPrintf(buffer, "size     = %d (%s)\n",
+               stack->size,     ErrorToString(IsSizeOk(stack)));
+    DumpPrintf(buffer, "capacity = %d (%s)\n\n",
+               stack->capacity, ErrorToString(IsCapacityOk(stack)));
+
+    StackError dataError = IsDataOk(stack);
+
+    if (StackLevel(stack) >= MID_LEVEL && !dataError) {
+        DumpPrintf(buffer, "Stack canaries:\n");
+        DumpPrintf(buffer, "    canaryLeft[%p] = %ud (%s)\n",
+                   &stack->canaryLeft,  stack->canaryLeft,  (stack->canaryLeft  == CANARY) ?
+                   "Ok" : "IRRUPTION");
+        DumpPrintf(buffer, "    canaryRight[%p] = %ud (%s)\n",
+                   &stack->canaryRight, stack->canaryRight, (stack->canaryRight == CANARY) ?
+                   "Ok" : "IRRUPTION");
+
+        canary* leftDataCanaryLocation  = (canary*)(stack->data - StackShift(stack));
+        canary* rightDataCanaryLocation = (canary*)(stack->data + stack->capacity * sizeof(T));
+        DumpPrintf(buffer, "Data canaries:\n");
+        DumpPrintf(buffer, "    canaryLeft[%p] = %ud (%s)\n",
+                   leftDataCanaryLocation,  *leftDataCanaryLocation,  (*leftDataCanaryLocation  == CANARY) ?
+                   "Ok" : "IRRUPTION");
+        DumpPrintf(buffer, "    canaryRight[%p] = %ud (%s)\n\n",
+                   rightDataCanaryLocation, *rightDataCanaryLocation, (*rightDataCanaryLocation == CANARY) ?
+                   "Ok" : "IRRUPTION");
+    }
+
+    if (StackLevel(stack) >= HIGH_LEVEL && !dataError) {
+        hashValue* stackHashLocation = (hashValue*)(stack->data - 2 * sizeof(hashValue));
+        hashValue curHash = GetStackHash(stack);
+
+        DumpPrintf(buffer, "Stack hashes:\n");
+        DumpPrintf(buffer, "    Stored stack hash[%p] = %llud\n",
+                   stackHashLocation, (unsigned long long)*stackHashLocation);
+        DumpPrintf(buffer, "    Current stack hash = %llud\n", (unsigned long long)curHash);
+        DumpPrintf(buffer, "    %s\n", (*stackHashLocation == curHash) ?
+                   "(Hashes are equal)" : "(HASHES AREN'T EQUAL)");
+
+        hashValue* dataHashLocation = (hashValue*)(stack->data - sizeof(hashValue));
+        curHash = GetDataHash(stack);
+        DumpPrintf(buffer, "Data hashes:\n");
+        DumpPrintf(buffer, "    Stored data hash[%p] = %llud\n",
+                   dataHashLocation, (unsigned long long)*dataHashLocation);
+        DumpPrintf(buffer, "    Current data hash = %llud\n", (unsigned long long)curHash);
+        DumpPrintf(buffer, "    %s\n\n",
+                   (*dataHashLocation == curHash) ?
+                   "(Hashes are equal)" : "(HASHES AREN'T EQUAL)");
+
+        #if (STACK_HASH_CHECK == DIRTY_HASH_CHECK)
+            DumpPrintf(buffer, "Dirty words: [%llu, %llu)\n\n",
+                       (unsigned long long)stack->dirtyBegin, (unsigned long long)stack->dirtyEnd);
+        #endif
+    }
+
+    DumpPrintf(buffer, "data[%p] (%s)\n",
+               stack->data - StackShift(stack), ErrorToString(dataError));
+    if (StackLevel(stack) >= HIGH_LEVEL && !dataError) {
+        DumpPrintf(buffer, "{\n");
+
+        if (options.headCount == DUMP_ALL) {
+            for (int32_t curIdx = 0; curIdx < stack->capacity; curIdx++) {
+                StackRenderTextElem(stack, buffer, curIdx);
+            }
+        }
+        else {
+            int32_t headEnd   = 0;
+            int32_t tailBegin = 0;
+            GetDumpView(stack, options, &headEnd, &tailBegin);
+
+            for (int32_t curIdx = 0; curIdx < headEnd; curIdx++) {
+                StackRenderTextElem(stack, buffer, curIdx);
+            }
+
+            if (tailBegin > headEnd)
+                DumpPrintf(buffer, "   ... %d elements skipped ...\n", tailBegin - headEnd);
+
+            for (int32_t curIdx = tailBegin; curIdx < stack->size; curIdx++) {
+                StackRenderTextElem(stack, buffer, curIdx);
+            }
+
+            DumpPrintf(buffer, "   [%d, %d) unused (%s)\n", stack->size, stack->capacity,
+                       IsPoisonOk(stack) ? "NOT POISON, BUT SHOULD BE" : "Poison");
+        }
+
+        DumpPrintf(buffer, "}\n");
+    }
+}
+
+STACK_TEMPLATE
+void StackRenderJsonElems(STACK_TYPE* stack, DumpBuffer* buffer, int32_t beginIdx, int32_t endIdx) {
+    DumpWrite(buffer, "[", 1);
+
+    for (int32_t curIdx = beginIdx; curIdx < endIdx; curIdx++) {
+        DumpWrite(buffer, (curIdx == beginIdx) ? "\"" : ",\"", (curIdx == beginIdx) ? 1 : 2);
+        StackElemInfo<T>::Print(buffer, *(T*)(stack->data + curIdx * sizeof(T)));
+        DumpWrite(buffer, "\"", 1);
+    }
+
+    DumpWrite(buffer, "]", 1);
+}
+
+STACK_TEMPLATE
+void StackRenderJson(STACK_TYPE* stack, VarInfo dumpInfo, DumpBuffer* buffer, DumpOptions options) {
+    DumpPrintf(buffer, "{\"dump\":{\"file\":");
+    DumpJsonString(buffer, dumpInfo.file);
+    DumpPrintf(buffer, ",\"function\":");
+    DumpJsonString(buffer, dumpInfo.function);
+    DumpPrintf(buffer, ",\"line\":%d,\"name\":", dumpInfo.line);
+    DumpJsonString(buffer, dumpInfo.name);
+
+    DumpPrintf(buffer, "},\"stack\":{\"type\":");
+    DumpJsonString(buffer, StackElemInfo<T>::NAME);
+    DumpPrintf(buffer, ",\"address\":\"%p\",\"name\":", stack);
+    DumpJsonString(buffer, stack->creationInfo.name);
+    DumpPrintf(buffer, ",\"file\":");
+    DumpJsonString(buffer, stack->creationInfo.file);
+    DumpPrintf(buffer, ",\"line\":%d,\"function\":", stack->creationInfo.line);
+    DumpJsonString(buffer, stack->creationInfo.function);
+
+    DumpPrintf(buffer, "},\"error\":");
+    DumpJsonString(buffer, ErrorToString(IsAllOk(stack)));
+    DumpPrintf(buffer, ",\"level\":%d,\"size\":%d,\"capacity\":%d,"
+                       "\"checks\":{\"count\":%llu,\"timeNs\":%llu,\"mode\":%d}",
+               StackLevel(stack), stack->size, stack->capacity,
+               (unsigned long long)stack->verifyState.counter,
+               (unsigned long long)stack->verifyState.checkTime, stack->verifyPolicy.mode);
+
+    StackError dataError = IsDataOk(stack);
+
+    if (StackLevel(stack) >= MID_LEVEL && !dataError) {
+        canary* leftDataCanaryLocation  = (canary*)(stack->data - StackShift(stack));
+        canary* rightDataCanaryLocation = (canary*)(stack->data + stack->capacity * sizeof(T));
+
+        DumpPrintf(buffer, ",\"canaries\":{\"stack\":[%u,%u],\"data\":[%u,%u]}",
+                   stack->canaryLeft, stack->canaryRight,
+                   *leftDataCanaryLocation, *rightDataCanaryLocation);
+    }
+
+    if (StackLevel(stack) >= HIGH_LEVEL && !dataError) {
+        DumpPrintf(buffer, ",\"hashes\":{\"stack\":{\"stored\":%llu,\"current\":%llu},"
+                                        "\"data\":{\"stored\":%llu,\"current\":%llu}}",
+                   (unsigned long long)*(hashValue*)(stack->data - 2 * sizeof(hashValue)),
+                   (unsigned long long)GetStackHash(stack),
+                   (unsigned long long)*(hashValue*)(stack->data - sizeof(hashValue)),
+                   (unsigned long long)GetDataHash(stack));
+
+        int32_t headEnd   = 0;
+        int32_t tailBegin = 0;
+        GetDumpView(stack, options, &headEnd, &tailBegin);
+
+        DumpPrintf(buffer, ",\"elements\":{\"head\":");
+        StackRenderJsonElems(stack, buffer, 0, headEnd);
+        DumpPrintf(buffer, ",\"skipped\":%d,\"tail\":", tailBegin - headEnd);
+        StackRenderJsonElems(stack, buffer, tailBegin, (stack->size > 0) ? stack->size : 0);
+        DumpPrintf(buffer, ",\"unusedPoisoned\":%s}", IsPoisonOk(stack) ? "false" : "true");
+    }
+
+    DumpPrintf(buffer, ",\"data\":\"%p\"}\n", stack->data - StackShift(stack));
+}
+
+STACK_TEMPLATE
+void StackRenderBinary(STACK_TYPE* stack, VarInfo dumpInfo, DumpBuffer* buffer, DumpOptions options) {
+    (void)dumpInfo;
+
+    DumpBinaryHeader header = {};
+    header.magic    = DUMP_BINARY_MAGIC;
+    header.version  = DUMP_BINARY_VERSION;
+    header.elemSize = (uint16_t)sizeof(T);
+    header.level    = StackLevel(stack);
+    header.error    = IsAllOk(stack);
+    header.size     = stack->size;
+    header.capacity = stack->capacity;
+    header.line     = stack->creationInfo.line;
+
+    StackError dataError = IsDataOk(stack);
+
+    if (StackLevel(stack) >= MID_LEVEL && !dataError) {
+        header.stackCanaries[0] = stack->canaryLeft;
+        header.stackCanaries[1] = stack->canaryRight;
+        header.dataCanaries[0]  = *(canary*)(stack->data - StackShift(stack));
+        header.dataCanaries[1]  = *(canary*)(stack->data + stack->capacity * sizeof(T));
+    }
+
+    int32_t headEnd   = 0;
+    int32_t tailBegin = 0;
+
+    if (StackLevel(stack) >= HIGH_LEVEL && !dataError) {
+        header.storedStackHash  = *(hashValue*)(stack->data - 2 * sizeof(hashValue));
+        header.currentStackHash = GetStackHash(stack);
+        header.storedDataHash   = *(hashValue*)(stack->data - sizeof(hashValue));
+        header.currentDataHash  = GetDataHash(stack);
+
+        GetDumpView(stack, options, &headEnd, &tailBegin);
+        header.headCount = headEnd;
+        header.tailCount = ((stack->size > 0) ? stack->size : 0) - tailBegin;
+    }
+
+    const char* strings[] = { StackElemInfo<T>::NAME, stack->creationInfo.name,
+                              stack->creationInfo.file, stack->creationInfo.function };
+    for (const char* curString : strings) {
+        header.stringsSize += (uint32_t)strlen((curString != nullptr) ? curString : "") + 1;
+    }
+
+    DumpWrite(buffer, &header, sizeof(header));
+    for (const char* curString : strings) {
+        if (curString == nullptr) curString = "";
+        DumpWrite(buffer, curString, strlen(curString) + 1);
+    }
+
+    DumpWrite(buffer, stack->data,                         header.headCount * sizeof(T));
+    DumpWrite(buffer, stack->data + tailBegin * sizeof(T), header.tailCount * sizeof(T));
+}
+
+STACK_TEMPLATE
+int32_t StackStatsMerge(STACK_TYPE* stack) {
+    #if (STACK_STATS)
+        int32_t error = StatsMerge(stack->creationInfo, &stack->stats);
+        stack->stats  = {};
+
+        return error;
+    #else
+        (void)stack;
+
+        return 0;
+    #endif
+}
+
+STACK_TEMPLATE
+uint8_t* StackIncrease(STACK_TYPE* stack) {
+    int32_t newCapacity = (int32_t)(stack->capacity * stack->policy.increaseMultiplier);
+
+    if (newCapacity <= stack->capacity)          newCapacity = stack->capacity + 1;
+    if (newCapacity <  stack->policy.minCapacity) newCapacity = stack->policy.minCapacity;
+
+    StatsAdd(stack, increases, 1);
+
+    return StackResize(stack, newCapacity);
+}
+
+STACK_TEMPLATE
+uint8_t* StackDecrease(STACK_TYPE* stack) {
+    int32_t newCapacity = (int32_t)(stack->capacity / stack->policy.decreaseMultiplier);
+
+    if (newCapacity <  stack->policy.minCapacity) newCapacity = stack->policy.minCapacity;
+    if (newCapacity <  stack->size)              newCapacity = stack->size;
+
+    StatsAdd(stack, decreases, 1);
+
+    return StackResize(stack, newCapacity);
+}
+
+STACK_TEMPLATE
+bool IsStackTooBig(STACK_TYPE* stack) {
+    if (stack->capacity <= stack->policy.minCapacity) return false;
+    if (IsStackInline(stack))                         return false;
+
+    return stack->size * stack->policy.decreaseThreshold <= stack->capacity;
+}
+
+STACK_TEMPLATE
+uint8_t* StackResize(STACK_TYPE* stack, int32_t newCapacity) {
+    CheckAllStack(stack);
+
+    // Hashes are stale inside StackVerifyScope, so they are refreshed before data hash check
+    if (stack->verifyState.scopeDepth > 0 && StackLevel(stack) >= HIGH_LEVEL)
+        WriteAllStackHash(stack);
+
+    #if (STACK_HASH_CHECK == DIRTY_HASH_CHECK)
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        CheckStack(stack, IsDataHashOk);
+        CheckStack(stack, IsPoisonOk);
+    }
+    #endif
+
+    assert(newCapacity >= stack->size && "STACK_OVERFLOW");
+
+    int32_t  oldCapacity            = stack->capacity;
+    uint64_t sizeOfData             = oldCapacity * sizeof(T);
+    uint64_t sizeOfNewData          = newCapacity * sizeof(T);
+
+    canary* rightDataCanaryLocation = (canary*)(stack->data + sizeOfData);
+    canary  cellCanary              = 0;
+
+    if (StackLevel(stack) >= MID_LEVEL) {
+        cellCanary                      = *rightDataCanaryLocation;
+        *rightDataCanaryLocation        = 0;
+    }
+
+    uint8_t* newPointer = nullptr;
+
+    if (IsStackInline(stack)) {
+        newPointer = (uint8_t*)stack->allocator.allocate(stack->allocator.context,
+                                                         StackProtectionSize(stack) + sizeOfNewData);
+        assert(newPointer  != nullptr && "MEMORY_RESIZE_ERR");
+
+        memcpy(newPointer, stack->inlineData, StackProtectionSize(stack) + sizeOfData);
+    }
+    else {
+        newPointer = (uint8_t*)stack->allocator.reallocate(stack->allocator.context,
+                                                           stack->data - StackShift(stack),
+                                                           StackProtectionSize(stack) + sizeOfData,
+                                                           StackProtectionSize(stack) + sizeOfNewData);
+        assert(newPointer  != nullptr && "MEMORY_RESIZE_ERR");
+    }
+
+    stack->data         = newPointer + StackShift(stack);
+    stack->capacity     = newCapacity;
+
+    StatsAdd(stack, reallocBytes, StackProtectionSize(stack) + sizeOfNewData);
+
+    if (StackLevel(stack) >= MID_LEVEL) {
+        rightDataCanaryLocation  = (canary*)(stack->data + sizeOfNewData);
+        *rightDataCanaryLocation = cellCanary;
+    }
+
+    if (StackLevel(stack) >= HIGH_LEVEL) {
+        StackFillPoison(stack, oldCapacity, newCapacity);
+
+        WriteAllStackHash(stack);
+    }
+
+    CheckAllStack(stack);
+
+    return stack->data;
+}
+
+#endif
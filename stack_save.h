@@ -0,0 +1,96 @@
+#ifndef _STACK_SAVE_H_
+#define _STACK_SAVE_H_
+
+#include "stack.h"
+
+#define StackLoad(stack, type, instream)                          \
+    Stack<type, DYNAMIC_LEVEL> stack = {};                        \
+    StackLoad_(&stack, instream LOCATION (stack));
+
+#define StackLoadType(stack, type, level, instream)               \
+    Stack<type, level> stack = {};                                \
+    StackLoad_(&stack, instream LOCATION (stack));
+
+const uint64_t SAVE_MAGIC          = 0x4B43415453564153;
+const uint32_t SAVE_VERSION        = 1;
+const size_t   SAVE_TYPE_NAME_SIZE = 16;
+const uint32_t SAVE_CHUNK_SIZE     = 1 << 20;
+
+//-------------------------------------------------------------------------------------------
+//! Header of saved stack
+//!
+//! @note It is followed by size elements in chunks of chunkSize bytes, every chunk is
+//!       followed by its hash. headerHash is hash of all fields before it, typeName is
+//!       StackElemInfo<T>::NAME
+//-------------------------------------------------------------------------------------------
+
+struct StackSaveHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t elemSize;
+
+    char typeName[SAVE_TYPE_NAME_SIZE];
+
+    int32_t level;
+    int32_t hashType;
+    int32_t size;
+    int32_t capacity;
+
+    uint32_t chunkSize;
+    uint32_t reserved;
+
+    hashValue headerHash;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Writes stack in binary form
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] outstream Pointer to the stream, it may be pipe
+//!
+//! @return 0 if no errors, FILE_INVALID if stream doesn't take all bytes
+//!
+//! @note Chunks are written straight from stack data with no copy, so stdio passes them
+//!       to write(2) without its buffer
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackSave(STACK_TYPE* stack, FILE* outstream);
+
+//-------------------------------------------------------------------------------------------
+//! Creates stack from StackSave output from StackLoad or StackLoadType macro
+//!
+//! @param [out] stack Pointer to the stack structure which will be created
+//! @param [in]  instream Pointer to the stream, it is read once from current position
+//! @param [in]  policy Growth policy of stack
+//! @param [in]  allocator Source of data memory
+//!
+//! @return 0 if no errors, FILE_INVALID if header is wrong or stream ends,
+//!         DATA_HASH_IRRUPTION if chunk hash is wrong
+//!
+//! @note Stack gets saved level and capacity. StackLoad makes DYNAMIC_LEVEL stack which
+//!       loads any level, stack with fixed Level loads only snapshot of the same level.
+//!       Data is allocated once and chunks are read straight in it, then stack hashes are
+//!       written and stack is checked. On error stack is left destroyed (STACK_FREE)
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+int32_t StackLoad_(STACK_TYPE* stack, FILE* instream, VarInfo creationInfo,
+                   GrowthPolicy policy = DEFAULT_GROWTH_POLICY,
+                   StackAllocator allocator = MALLOC_ALLOCATOR);
+
+//-------------------------------------------------------------------------------------------
+//! Gets hash of save header
+//!
+//! @param [in] header Pointer to the header
+//!
+//! @return Hash of fields before headerHash
+//-------------------------------------------------------------------------------------------
+
+inline hashValue GetSaveHeaderHash(StackSaveHeader* header) {
+    return GetHash((uint8_t*)header, (uint8_t*)&header->headerHash - (uint8_t*)header);
+}
+
+#include "stack_save_impl.h"
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef _STACK_SAVE_IMPL_H_
+#define _STACK_SAVE_IMPL_H_
+
+STACK_TEMPLATE
+int32_t StackSave(STACK_TYPE* stack, FILE* outstream) {
+    CheckStack(stack, IsAllOk);
+    assert(outstream != nullptr && "STREAM_NULL");
+
+    StackSaveHeader header = {};
+    memset(&header, 0, sizeof(header));
+
+    header.magic     = SAVE_MAGIC;
+    header.version   = SAVE_VERSION;
+    header.elemSize  = sizeof(T);
+    strncpy(header.typeName, StackElemInfo<T>::NAME, SAVE_TYPE_NAME_SIZE - 1);
+
+    header.level     = StackLevel(stack);
+    header.hashType  = STACK_HASH;
+    header.size      = stack->size;
+    header.capacity  = stack->capacity;
+    header.chunkSize = SAVE_CHUNK_SIZE;
+
+    header.headerHash = GetSaveHeaderHash(&header);
+
+    if (fwrite(&header, sizeof(header), 1, outstream) != 1) return FILE_INVALID;
+
+    uint64_t sizeOfData = (uint64_t)stack->size * sizeof(T);
+
+    for (uint64_t chunkBegin = 0; chunkBegin < sizeOfData; chunkBegin += SAVE_CHUNK_SIZE) {
+        uint64_t chunkSize = sizeOfData - chunkBegin;
+        if (chunkSize > SAVE_CHUNK_SIZE) chunkSize = SAVE_CHUNK_SIZE;
+
+        hashValue chunkHash = GetHash(stack->data + chunkBegin, chunkSize);
+
+        if (fwrite(stack->data + chunkBegin, 1, chunkSize, outstream) != chunkSize ||
+            fwrite(&chunkHash, sizeof(chunkHash), 1, outstream) != 1)
+            return FILE_INVALID;
+    }
+
+    if (fflush(outstream) != 0) return FILE_INVALID;
+
+    return 0;
+}
+
+STACK_TEMPLATE
+int32_t StackLoad_(STACK_TYPE* stack, FILE* instream, VarInfo creationInfo,
+                   GrowthPolicy policy, StackAllocator allocator) {
+    assert(stack    != nullptr && "STACK_NULL");
+    assert(instream != nullptr && "STREAM_NULL");
+
+    StackSaveHeader header = {};
+
+    bool isHeaderOk = fread(&header, sizeof(header), 1, instream) == 1;
+
+    isHeaderOk = isHeaderOk && header.magic      == SAVE_MAGIC   &&
+                               header.version    == SAVE_VERSION &&
+                               header.elemSize   == sizeof(T)    &&
+                               header.hashType   == STACK_HASH   &&
+                               header.headerHash == GetSaveHeaderHash(&header);
+
+    isHeaderOk = isHeaderOk && strncmp(header.typeName, StackElemInfo<T>::NAME,
+                                       SAVE_TYPE_NAME_SIZE) == 0;
+
+    isHeaderOk = isHeaderOk && header.level >= LOW_LEVEL && header.level <= HIGH_LEVEL &&
+                 (Level == DYNAMIC_LEVEL || header.level == Level);
+
+    isHeaderOk = isHeaderOk && header.size >= 0 && header.capacity >= header.size &&
+                 header.chunkSize > 0;
+
+    if (!isHeaderOk) {
+        stack->level = (Level == DYNAMIC_LEVEL) ? STACK_DEBUG : Level;
+        stack->data  = (uint8_t*)FREE_VALUE + StackShift(stack);
+        stack->size  = -1;
+
+        return FILE_INVALID;
+    }
+
+    StackCtor_(stack, creationInfo, header.capacity, policy, header.level, allocator);
+
+    uint64_t sizeOfData = (uint64_t)header.size * sizeof(T);
+    int32_t  error      = NO_ERROR;
+
+    for (uint64_t chunkBegin = 0; chunkBegin < sizeOfData; chunkBegin += header.chunkSize) {
+        uint64_t chunkSize = sizeOfData - chunkBegin;
+        if (chunkSize > header.chunkSize) chunkSize = header.chunkSize;
+
+        hashValue chunkHash = 0;
+
+        if (fread(stack->data + chunkBegin, 1, chunkSize, instream) != chunkSize ||
+            fread(&chunkHash, sizeof(chunkHash), 1, instream) != 1) {
+            error = FILE_INVALID;
+            break;
+        }
+
+        if (GetHash(stack->data + chunkBegin, chunkSize) != chunkHash) {
+            error = DATA_HASH_IRRUPTION;
+            break;
+        }
+    }
+
+    if (error) {
+        // Data is overwritten behind hashes, so it is poisoned back before destruction
+        if (StackLevel(stack) >= HIGH_LEVEL) {
+            StackFillPoison(stack, 0, stack->capacity);
+            WriteAllStackHash(stack);
+        }
+
+        StackDtor(stack);
+
+        return error;
+    }
+
+    stack->size     = header.size;
+    stack->peakSize = header.size;
+
+    if (StackLevel(stack) >= HIGH_LEVEL)
+        WriteAllStackHash(stack);
+
+    return IsAllOk(stack);
+}
+
+#endif
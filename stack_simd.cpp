@@ -0,0 +1,356 @@
+#include "stack_simd.h"
+
+#ifdef STACK_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+hashValue GetHashScalar(const uint8_t* pointer, uint64_t size) {
+    hashValue hashSum   = 0;
+    uint64_t  curPower  = 1;
+    for (uint64_t curByte = 0; curByte < size; curByte++) {
+        hashSum  += *(pointer + curByte) * curPower;
+        curPower *= HASH_BASE;
+    }
+
+    return hashSum;
+}
+
+hashValue GetWordsHashScalar(const uint8_t* data, uint64_t beginWord, uint64_t endWord) {
+    hashValue hashSum = 0;
+    for (uint64_t curWord = beginWord; curWord < endWord; curWord++) {
+        uint64_t word = 0;
+        memcpy(&word, data + curWord * sizeof(uint64_t), sizeof(uint64_t));
+
+        hashSum += GetWordHash(curWord, word);
+    }
+
+    return hashSum;
+}
+
+void FillPatternScalar(uint8_t* dest, const uint8_t* pattern, uint32_t patternSize, uint64_t count) {
+    for (uint64_t curCopy = 0; curCopy < count; curCopy++) {
+        memcpy(dest + curCopy * patternSize, pattern, patternSize);
+    }
+}
+
+bool IsPatternFilledScalar(const uint8_t* src, const uint8_t* pattern, uint32_t patternSize,
+                           uint64_t count) {
+    for (uint64_t curCopy = 0; curCopy < count; curCopy++) {
+        if (memcmp(src + curCopy * patternSize, pattern, patternSize) != 0) return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Adds tail bytes and lane sums of vector kernels to polynomial hash
+//!
+//! @param [in] laneSums Sums of lanes, laneSums[j] is sum of bytes at block position j
+//!                      multiplied by HASH_BASE^(block begin)
+//! @param [in] tail Pointer to the bytes after the last full block
+//! @param [in] tailSize Amount of tail bytes
+//! @param [in] tailPower HASH_BASE^(position of tail)
+//!
+//! @return Hash
+//-------------------------------------------------------------------------------------------
+
+static hashValue FinishBlocksHash(const uint64_t* laneSums, const uint8_t* tail, uint64_t tailSize,
+                                  uint64_t tailPower) {
+    hashValue hashSum  = 0;
+    uint64_t  curPower = 1;
+    for (uint32_t curLane = 0; curLane < SIMD_HASH_BLOCK; curLane++) {
+        hashSum  += laneSums[curLane] * curPower;
+        curPower *= HASH_BASE;
+    }
+
+    return hashSum + GetHashScalar(tail, tailSize) * tailPower;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Makes SIMD_HASH_BLOCK bytes of repeated pattern
+//!
+//! @param [out] block Pointer to the block
+//! @param [in]  pattern Pointer to the pattern
+//! @param [in]  patternSize Size of pattern, divides SIMD_HASH_BLOCK
+//-------------------------------------------------------------------------------------------
+
+static void MakePatternBlock(uint8_t* block, const uint8_t* pattern, uint32_t patternSize) {
+    for (uint32_t curByte = 0; curByte < SIMD_HASH_BLOCK; curByte++) {
+        block[curByte] = pattern[curByte % patternSize];
+    }
+}
+
+#ifdef STACK_SIMD_X86
+
+__attribute__((target("sse2")))
+hashValue GetHashSse2(const uint8_t* pointer, uint64_t size) {
+    const uint32_t VECTORS_COUNT = SIMD_HASH_BLOCK / 2;
+
+    __m128i zero = _mm_setzero_si128();
+
+    __m128i lowSums [VECTORS_COUNT] = {};
+    __m128i highSums[VECTORS_COUNT] = {};
+
+    uint64_t blockPower = 1;
+    uint64_t powerStep  = powllu(HASH_BASE, SIMD_HASH_BLOCK);
+
+    uint64_t blocksCount = size / SIMD_HASH_BLOCK;
+    for (uint64_t curBlock = 0; curBlock < blocksCount; curBlock++) {
+        __m128i lowPower  = _mm_set1_epi64x((int64_t)blockPower);
+        __m128i highPower = _mm_set1_epi64x((int64_t)(blockPower >> 32));
+
+        for (uint32_t curPart = 0; curPart < SIMD_HASH_BLOCK / 16; curPart++) {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(pointer + curBlock * SIMD_HASH_BLOCK +
+                                                             curPart * 16));
+
+            __m128i words[2]  = { _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+            for (uint32_t curWords = 0; curWords < 2; curWords++) {
+                __m128i dwords[2] = { _mm_unpacklo_epi16(words[curWords], zero),
+                                      _mm_unpackhi_epi16(words[curWords], zero) };
+
+                for (uint32_t curDwords = 0; curDwords < 2; curDwords++) {
+                    uint32_t vectorIdx = curPart * 8 + curWords * 4 + curDwords * 2;
+
+                    __m128i qwords = _mm_unpacklo_epi32(dwords[curDwords], zero);
+                    lowSums [vectorIdx] = _mm_add_epi64(lowSums [vectorIdx], _mm_mul_epu32(qwords, lowPower));
+                    highSums[vectorIdx] = _mm_add_epi64(highSums[vectorIdx], _mm_mul_epu32(qwords, highPower));
+
+                    qwords = _mm_unpackhi_epi32(dwords[curDwords], zero);
+                    lowSums [vectorIdx + 1] = _mm_add_epi64(lowSums [vectorIdx + 1], _mm_mul_epu32(qwords, lowPower));
+                    highSums[vectorIdx + 1] = _mm_add_epi64(highSums[vectorIdx + 1], _mm_mul_epu32(qwords, highPower));
+                }
+            }
+        }
+
+        blockPower *= powerStep;
+    }
+
+    uint64_t laneSums[SIMD_HASH_BLOCK] = {};
+    for (uint32_t curVector = 0; curVector < VECTORS_COUNT; curVector++) {
+        __m128i sums = _mm_add_epi64(lowSums[curVector], _mm_slli_epi64(highSums[curVector], 32));
+        _mm_storeu_si128((__m128i*)(laneSums + 2 * curVector), sums);
+    }
+
+    return FinishBlocksHash(laneSums, pointer + blocksCount * SIMD_HASH_BLOCK,
+                            size % SIMD_HASH_BLOCK, blockPower);
+}
+
+__attribute__((target("sse2")))
+void FillPatternSse2(uint8_t* dest, const uint8_t* pattern, uint32_t patternSize, uint64_t count) {
+    if (16 % patternSize != 0) {
+        FillPatternScalar(dest, pattern, patternSize, count);
+        return;
+    }
+
+    uint8_t block[SIMD_HASH_BLOCK] = {};
+    MakePatternBlock(block, pattern, patternSize);
+
+    __m128i vector = _mm_loadu_si128((const __m128i*)block);
+
+    uint64_t size    = count * patternSize;
+    uint64_t curByte = 0;
+    for (; curByte + 16 <= size; curByte += 16) {
+        _mm_storeu_si128((__m128i*)(dest + curByte), vector);
+    }
+
+    memcpy(dest + curByte, block, size - curByte);
+}
+
+__attribute__((target("sse2")))
+bool IsPatternFilledSse2(const uint8_t* src, const uint8_t* pattern, uint32_t patternSize,
+                         uint64_t count) {
+    if (16 % patternSize != 0) return IsPatternFilledScalar(src, pattern, patternSize, count);
+
+    uint8_t block[SIMD_HASH_BLOCK] = {};
+    MakePatternBlock(block, pattern, patternSize);
+
+    __m128i vector = _mm_loadu_si128((const __m128i*)block);
+
+    uint64_t size    = count * patternSize;
+    uint64_t curByte = 0;
+    for (; curByte + 16 <= size; curByte += 16) {
+        __m128i isEqual = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(src + curByte)), vector);
+        if (_mm_movemask_epi8(isEqual) != 0xFFFF) return false;
+    }
+
+    return memcmp(src + curByte, block, size - curByte) == 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Multiplies 64-bit lanes by constant modulo 2^64
+//-------------------------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static inline __m256i MultiplyAvx2(__m256i value, __m256i lowConst, __m256i highConst) {
+    __m256i low   = _mm256_mul_epu32(value, lowConst);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(value, 32), lowConst),
+                                     _mm256_mul_epu32(value, highConst));
+
+    return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx2")))
+hashValue GetHashAvx2(const uint8_t* pointer, uint64_t size) {
+    const uint32_t VECTORS_COUNT = SIMD_HASH_BLOCK / 4;
+
+    __m256i lowSums [VECTORS_COUNT] = {};
+    __m256i highSums[VECTORS_COUNT] = {};
+
+    uint64_t blockPower = 1;
+    uint64_t powerStep  = powllu(HASH_BASE, SIMD_HASH_BLOCK);
+
+    uint64_t blocksCount = size / SIMD_HASH_BLOCK;
+    for (uint64_t curBlock = 0; curBlock < blocksCount; curBlock++) {
+        __m256i lowPower  = _mm256_set1_epi64x((int64_t)blockPower);
+        __m256i highPower = _mm256_set1_epi64x((int64_t)(blockPower >> 32));
+
+        for (uint32_t curPart = 0; curPart < SIMD_HASH_BLOCK / 16; curPart++) {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(pointer + curBlock * SIMD_HASH_BLOCK +
+                                                             curPart * 16));
+
+            __m256i qwords[4] = { _mm256_cvtepu8_epi64(bytes),
+                                  _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 4)),
+                                  _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 8)),
+                                  _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 12)) };
+
+            for (uint32_t curQwords = 0; curQwords < 4; curQwords++) {
+                uint32_t vectorIdx = curPart * 4 + curQwords;
+
+                lowSums [vectorIdx] = _mm256_add_epi64(lowSums [vectorIdx],
+                                                       _mm256_mul_epu32(qwords[curQwords], lowPower));
+                highSums[vectorIdx] = _mm256_add_epi64(highSums[vectorIdx],
+                                                       _mm256_mul_epu32(qwords[curQwords], highPower));
+            }
+        }
+
+        blockPower *= powerStep;
+    }
+
+    uint64_t laneSums[SIMD_HASH_BLOCK] = {};
+    for (uint32_t curVector = 0; curVector < VECTORS_COUNT; curVector++) {
+        __m256i sums = _mm256_add_epi64(lowSums[curVector], _mm256_slli_epi64(highSums[curVector], 32));
+        _mm256_storeu_si256((__m256i*)(laneSums + 4 * curVector), sums);
+    }
+
+    return FinishBlocksHash(laneSums, pointer + blocksCount * SIMD_HASH_BLOCK,
+                            size % SIMD_HASH_BLOCK, blockPower);
+}
+
+__attribute__((target("avx2")))
+hashValue GetWordsHashAvx2(const uint8_t* data, uint64_t beginWord, uint64_t endWord) {
+    __m256i lowMultiplier   = _mm256_set1_epi64x((int64_t)HASH_WORD_MULTIPLIER);
+    __m256i highMultiplier  = _mm256_set1_epi64x((int64_t)(HASH_WORD_MULTIPLIER >> 32));
+    __m256i lowMixFirst     = _mm256_set1_epi64x((int64_t)HASH_MIX_FIRST);
+    __m256i highMixFirst    = _mm256_set1_epi64x((int64_t)(HASH_MIX_FIRST >> 32));
+    __m256i lowMixSecond    = _mm256_set1_epi64x((int64_t)HASH_MIX_SECOND);
+    __m256i highMixSecond   = _mm256_set1_epi64x((int64_t)(HASH_MIX_SECOND >> 32));
+
+    __m256i wordsIdx  = _mm256_add_epi64(_mm256_set1_epi64x((int64_t)beginWord),
+                                         _mm256_set_epi64x(3, 2, 1, 0));
+    __m256i idxSalt   = MultiplyAvx2(wordsIdx, lowMultiplier, highMultiplier);
+    __m256i saltStep  = _mm256_set1_epi64x((int64_t)(4 * HASH_WORD_MULTIPLIER));
+
+    __m256i hashSums  = _mm256_setzero_si256();
+
+    uint64_t curWord = beginWord;
+    for (; curWord + 4 <= endWord; curWord += 4) {
+        __m256i words = _mm256_loadu_si256((const __m256i*)(data + curWord * sizeof(uint64_t)));
+
+        words = _mm256_xor_si256(words, idxSalt);
+
+        words = _mm256_xor_si256(words, _mm256_srli_epi64(words, 33));
+        words = MultiplyAvx2(words, lowMixFirst, highMixFirst);
+        words = _mm256_xor_si256(words, _mm256_srli_epi64(words, 33));
+        words = MultiplyAvx2(words, lowMixSecond, highMixSecond);
+        words = _mm256_xor_si256(words, _mm256_srli_epi64(words, 33));
+
+        hashSums = _mm256_add_epi64(hashSums, words);
+        idxSalt  = _mm256_add_epi64(idxSalt, saltStep);
+    }
+
+    uint64_t laneSums[4] = {};
+    _mm256_storeu_si256((__m256i*)laneSums, hashSums);
+
+    return laneSums[0] + laneSums[1] + laneSums[2] + laneSums[3] +
+           GetWordsHashScalar(data, curWord, endWord);
+}
+
+__attribute__((target("avx2")))
+void FillPatternAvx2(uint8_t* dest, const uint8_t* pattern, uint32_t patternSize, uint64_t count) {
+    if (SIMD_HASH_BLOCK % patternSize != 0) {
+        FillPatternScalar(dest, pattern, patternSize, count);
+        return;
+    }
+
+    uint8_t block[SIMD_HASH_BLOCK] = {};
+    MakePatternBlock(block, pattern, patternSize);
+
+    __m256i vector = _mm256_loadu_si256((const __m256i*)block);
+
+    uint64_t size    = count * patternSize;
+    uint64_t curByte = 0;
+    for (; curByte + 32 <= size; curByte += 32) {
+        _mm256_storeu_si256((__m256i*)(dest + curByte), vector);
+    }
+
+    memcpy(dest + curByte, block, size - curByte);
+}
+
+__attribute__((target("avx2")))
+bool IsPatternFilledAvx2(const uint8_t* src, const uint8_t* pattern, uint32_t patternSize,
+                         uint64_t count) {
+    if (SIMD_HASH_BLOCK % patternSize != 0) return IsPatternFilledScalar(src, pattern, patternSize, count);
+
+    uint8_t block[SIMD_HASH_BLOCK] = {};
+    MakePatternBlock(block, pattern, patternSize);
+
+    __m256i vector = _mm256_loadu_si256((const __m256i*)block);
+
+    uint64_t size    = count * patternSize;
+    uint64_t curByte = 0;
+    for (; curByte + 32 <= size; curByte += 32) {
+        __m256i isEqual = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(src + curByte)), vector);
+        if (_mm256_movemask_epi8(isEqual) != -1) return false;
+    }
+
+    return memcmp(src + curByte, block, size - curByte) == 0;
+}
+
+#endif
+
+//-------------------------------------------------------------------------------------------
+//! Chooses the best kernels which CPU supports and STACK_SIMD environment variable allows
+//!
+//! @return Kernels
+//!
+//! @note STACK_SIMD may be "scalar", "sse2" or "avx2"
+//-------------------------------------------------------------------------------------------
+
+static SimdKernels ChooseSimdKernels() {
+    SimdKernels kernels = { "scalar", GetHashScalar, GetWordsHashScalar,
+                            FillPatternScalar, IsPatternFilledScalar };
+
+    #ifdef STACK_SIMD_X86
+        const char* maxSimd = getenv("STACK_SIMD");
+        bool isSse2Allowed  = (maxSimd == nullptr || strcmp(maxSimd, "scalar") != 0);
+        bool isAvx2Allowed  = (maxSimd == nullptr || strcmp(maxSimd, "avx2")   == 0);
+
+        __builtin_cpu_init();
+
+        if (isSse2Allowed && __builtin_cpu_supports("sse2"))
+            kernels = { "sse2", GetHashSse2, GetWordsHashScalar,
+                        FillPatternSse2, IsPatternFilledSse2 };
+
+        if (isAvx2Allowed && __builtin_cpu_supports("avx2"))
+            kernels = { "avx2", GetHashAvx2, GetWordsHashAvx2,
+                        FillPatternAvx2, IsPatternFilledAvx2 };
+    #endif
+
+    return kernels;
+}
+
+const SimdKernels* GetSimdKernels() {
+    static const SimdKernels kernels = ChooseSimdKernels();
+
+    return &kernels;
+}
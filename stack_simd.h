@@ -0,0 +1,100 @@
+#ifndef _STACK_SIMD_H_
+#define _STACK_SIMD_H_
+
+#include "stack.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define STACK_SIMD_X86
+#endif
+
+const uint32_t SIMD_HASH_BLOCK = 32;
+
+//-------------------------------------------------------------------------------------------
+//! Set of hash and poison kernels for one instruction set
+//!
+//! @note All sets give bit-exact results of scalar set
+//-------------------------------------------------------------------------------------------
+
+struct SimdKernels {
+    const char* name;
+
+    hashValue (*getHash)        (const uint8_t* pointer, uint64_t size);
+    hashValue (*getWordsHash)   (const uint8_t* data, uint64_t beginWord, uint64_t endWord);
+    void      (*fillPattern)    (uint8_t* dest, const uint8_t* pattern, uint32_t patternSize,
+                                 uint64_t count);
+    bool      (*isPatternFilled)(const uint8_t* src, const uint8_t* pattern, uint32_t patternSize,
+                                 uint64_t count);
+};
+
+//-------------------------------------------------------------------------------------------
+//! Gets kernels for current CPU, CPU is checked on the first call
+//!
+//! @return Pointer to the best supported set
+//-------------------------------------------------------------------------------------------
+
+const SimdKernels* GetSimdKernels();
+
+//-------------------------------------------------------------------------------------------
+//! Polynomial hash of bytes, sum of pointer[i] * HASH_BASE^i
+//!
+//! @param [in] pointer Pointer to the bytes
+//! @param [in] size Amount of bytes
+//!
+//! @return Hash
+//-------------------------------------------------------------------------------------------
+
+hashValue GetHashScalar(const uint8_t* pointer, uint64_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Sum of GetWordHash of full words in [beginWord, endWord)
+//!
+//! @param [in] data Pointer to the words
+//! @param [in] beginWord Index of the first word
+//! @param [in] endWord Index after the last word
+//!
+//! @return Hash
+//-------------------------------------------------------------------------------------------
+
+hashValue GetWordsHashScalar(const uint8_t* data, uint64_t beginWord, uint64_t endWord);
+
+//-------------------------------------------------------------------------------------------
+//! Writes count copies of pattern in dest
+//!
+//! @param [in] dest Pointer to the memory
+//! @param [in] pattern Pointer to the pattern
+//! @param [in] patternSize Size of pattern
+//! @param [in] count Amount of copies
+//-------------------------------------------------------------------------------------------
+
+void FillPatternScalar(uint8_t* dest, const uint8_t* pattern, uint32_t patternSize, uint64_t count);
+
+//-------------------------------------------------------------------------------------------
+//! Checks that src is count copies of pattern
+//!
+//! @param [in] src Pointer to the memory
+//! @param [in] pattern Pointer to the pattern
+//! @param [in] patternSize Size of pattern
+//! @param [in] count Amount of copies
+//!
+//! @return true if all copies are equal to pattern
+//-------------------------------------------------------------------------------------------
+
+bool IsPatternFilledScalar(const uint8_t* src, const uint8_t* pattern, uint32_t patternSize,
+                           uint64_t count);
+
+#ifdef STACK_SIMD_X86
+
+hashValue GetHashSse2        (const uint8_t* pointer, uint64_t size);
+void      FillPatternSse2    (uint8_t* dest, const uint8_t* pattern, uint32_t patternSize, uint64_t count);
+bool      IsPatternFilledSse2(const uint8_t* src, const uint8_t* pattern, uint32_t patternSize,
+                              uint64_t count);
+
+hashValue GetHashAvx2        (const uint8_t* pointer, uint64_t size);
+hashValue GetWordsHashAvx2   (const uint8_t* data, uint64_t beginWord, uint64_t endWord);
+void      FillPatternAvx2    (uint8_t* dest, const uint8_t* pattern, uint32_t patternSize, uint64_t count);
+bool      IsPatternFilledAvx2(const uint8_t* src, const uint8_t* pattern, uint32_t patternSize,
+                              uint64_t count);
+
+#endif
+
+#endif
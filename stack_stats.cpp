@@ -0,0 +1,191 @@
+#include <mutex>
+
+#include "stack.h"
+
+const size_t STATS_BEGINNING_CAPACITY = 16;
+
+struct StatsRegistry {
+    StatsSite* sites;
+
+    size_t size;
+    size_t capacity;
+
+    std::mutex mutex;
+};
+
+static StatsRegistry STATS_REGISTRY;
+
+//-------------------------------------------------------------------------------------------
+//! Compares creation places by file, function and line
+//-------------------------------------------------------------------------------------------
+
+static bool IsSameSite(VarInfo first, VarInfo second) {
+    if (first.line != second.line) return false;
+
+    return (first.file     == second.file     || strcmp(first.file,     second.file)     == 0) &&
+           (first.function == second.function || strcmp(first.function, second.function) == 0);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Finds creation place in registry, registry must be locked
+//!
+//! @return Pointer to the place or nullptr
+//-------------------------------------------------------------------------------------------
+
+static StatsSite* FindSite(VarInfo creationInfo) {
+    for (size_t curSite = 0; curSite < STATS_REGISTRY.size; curSite++) {
+        if (IsSameSite(STATS_REGISTRY.sites[curSite].creationInfo, creationInfo))
+            return &STATS_REGISTRY.sites[curSite];
+    }
+
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Finds creation place in registry or adds it, registry must be locked
+//!
+//! @return Pointer to the place or nullptr if memory is over
+//-------------------------------------------------------------------------------------------
+
+static StatsSite* AddSite(VarInfo creationInfo) {
+    StatsSite* site = FindSite(creationInfo);
+    if (site != nullptr) return site;
+
+    if (STATS_REGISTRY.size == STATS_REGISTRY.capacity) {
+        size_t newCapacity = (STATS_REGISTRY.capacity > 0) ? 2 * STATS_REGISTRY.capacity :
+                                                             STATS_BEGINNING_CAPACITY;
+
+        StatsSite* newSites = (StatsSite*)realloc(STATS_REGISTRY.sites,
+                                                  newCapacity * sizeof(StatsSite));
+        if (newSites == nullptr) return nullptr;
+
+        STATS_REGISTRY.sites    = newSites;
+        STATS_REGISTRY.capacity = newCapacity;
+    }
+
+    site  = &STATS_REGISTRY.sites[STATS_REGISTRY.size++];
+    *site = {};
+
+    site->creationInfo = creationInfo;
+
+    return site;
+}
+
+int32_t StatsMerge(VarInfo creationInfo, const StackStats* stats) {
+    assert(stats != nullptr && "STATS_NULL");
+
+    std::lock_guard<std::mutex> lock(STATS_REGISTRY.mutex);
+
+    StatsSite* site = AddSite(creationInfo);
+    if (site == nullptr) return -1;
+
+    site->stats.stacks       += stats->stacks;
+    site->stats.pushes       += stats->pushes;
+    site->stats.pops         += stats->pops;
+    site->stats.increases    += stats->increases;
+    site->stats.decreases    += stats->decreases;
+    site->stats.reallocBytes += stats->reallocBytes;
+    site->stats.checks       += stats->checks;
+    site->stats.checkTime    += stats->checkTime;
+    site->stats.hashChecks   += stats->hashChecks;
+    site->stats.hashTime     += stats->hashTime;
+
+    if (site->stats.peakSize < stats->peakSize) site->stats.peakSize = stats->peakSize;
+
+    for (uint32_t curBucket = 0; curBucket < STATS_HISTOGRAM_SIZE; curBucket++) {
+        site->stats.popSizes[curBucket] += stats->popSizes[curBucket];
+    }
+
+    return 0;
+}
+
+int32_t StatsGet(VarInfo creationInfo, StatsSite* site) {
+    assert(site != nullptr && "SITE_NULL");
+
+    std::lock_guard<std::mutex> lock(STATS_REGISTRY.mutex);
+
+    StatsSite* foundSite = FindSite(creationInfo);
+    if (foundSite == nullptr) return -1;
+
+    *site = *foundSite;
+
+    return 0;
+}
+
+int32_t StatsDump(FILE* outstream) {
+    assert(outstream != nullptr && "STREAM_NULL");
+
+    DumpBuffer buffer = {};
+    DumpBufferCtor(&buffer);
+
+    std::unique_lock<std::mutex> lock(STATS_REGISTRY.mutex);
+
+    for (size_t curSite = 0; curSite < STATS_REGISTRY.size; curSite++) {
+        StatsSite* site = &STATS_REGISTRY.sites[curSite];
+
+        DumpPrintf(&buffer, "\"%s\" from %s (%d), %s(): {\n", site->creationInfo.name,
+                   site->creationInfo.file, site->creationInfo.line, site->creationInfo.function);
+
+        DumpPrintf(&buffer, "stacks      = %llu\n",   (unsigned long long)site->stats.stacks);
+        DumpPrintf(&buffer, "pushes      = %llu\n",   (unsigned long long)site->stats.pushes);
+        DumpPrintf(&buffer, "pops        = %llu\n",   (unsigned long long)site->stats.pops);
+        DumpPrintf(&buffer, "peak size   = %d\n",     site->stats.peakSize);
+        DumpPrintf(&buffer, "increases   = %llu\n",   (unsigned long long)site->stats.increases);
+        DumpPrintf(&buffer, "decreases   = %llu\n",   (unsigned long long)site->stats.decreases);
+        DumpPrintf(&buffer, "reallocated = %llu bytes\n", (unsigned long long)site->stats.reallocBytes);
+        DumpPrintf(&buffer, "checks      = %llu (%llu ns)\n",
+                   (unsigned long long)site->stats.checks,     (unsigned long long)site->stats.checkTime);
+        DumpPrintf(&buffer, "hash checks = %llu (%llu ns)\n",
+                   (unsigned long long)site->stats.hashChecks, (unsigned long long)site->stats.hashTime);
+
+        DumpPrintf(&buffer, "capacity hint = %d\n", site->capacityHint);
+
+        DumpPrintf(&buffer, "size at pop:\n");
+        for (uint32_t curBucket = 0; curBucket < STATS_HISTOGRAM_SIZE; curBucket++) {
+            if (site->stats.popSizes[curBucket] == 0) continue;
+
+            DumpPrintf(&buffer, "    [%llu, %llu] = %llu\n",
+                       (curBucket > 0) ? 1ull << (curBucket - 1) : 0ull,
+                       (curBucket > 0) ? (1ull << curBucket) - 1 : 0ull,
+                       (unsigned long long)site->stats.popSizes[curBucket]);
+        }
+
+        DumpPrintf(&buffer, "}\n");
+    }
+
+    lock.unlock();
+
+    return DumpFinish(&buffer, outstream);
+}
+
+int32_t GetCapacityHint(VarInfo creationInfo) {
+    std::lock_guard<std::mutex> lock(STATS_REGISTRY.mutex);
+
+    StatsSite* site = FindSite(creationInfo);
+
+    return (site != nullptr) ? site->capacityHint : 0;
+}
+
+int32_t UpdateCapacityHint(VarInfo creationInfo, int32_t peakSize) {
+    std::lock_guard<std::mutex> lock(STATS_REGISTRY.mutex);
+
+    StatsSite* site = AddSite(creationInfo);
+    if (site == nullptr) return -1;
+
+    if (peakSize >= site->capacityHint)
+        site->capacityHint = peakSize;
+    else
+        site->capacityHint = (int32_t)(((int64_t)site->capacityHint + peakSize) / 2);
+
+    return 0;
+}
+
+void StatsReset() {
+    std::lock_guard<std::mutex> lock(STATS_REGISTRY.mutex);
+
+    free(STATS_REGISTRY.sites);
+
+    STATS_REGISTRY.sites    = nullptr;
+    STATS_REGISTRY.size     = 0;
+    STATS_REGISTRY.capacity = 0;
+}
@@ -0,0 +1,26 @@
+#include "stack_vm.h"
+
+int32_t GetVmStackEffect(VmOpcode opcode, int32_t* popped) {
+    assert(popped != nullptr && "POPPED_NULL");
+
+    switch (opcode) {
+        case VM_PUSH: *popped = 0; return  1;
+        case VM_POP:  *popped = 1; return -1;
+
+        case VM_ADD:
+        case VM_SUB:
+        case VM_MUL:
+        case VM_DIV:  *popped = 2; return -1;
+
+        case VM_DUP:  *popped = 1; return  1;
+        case VM_SWAP: *popped = 2; return  0;
+
+        case VM_JZ:
+        case VM_JNZ:  *popped = 1; return -1;
+
+        case VM_HALT:
+        case VM_JMP:
+        case VM_BLOCK:
+        default:      *popped = 0; return  0;
+    }
+}
@@ -0,0 +1,153 @@
+#ifndef _STACK_VM_H_
+#define _STACK_VM_H_
+
+#include <limits>
+#include <type_traits>
+
+#include "stack.h"
+
+#ifndef STACK_VM_COMPUTED_GOTO
+    #if defined(__GNUC__)
+        #define STACK_VM_COMPUTED_GOTO 1
+    #else
+        #define STACK_VM_COMPUTED_GOTO 0
+    #endif
+#endif
+
+enum VmOpcode : uint8_t {
+    VM_HALT = 0,
+    VM_PUSH,
+    VM_POP,
+    VM_ADD,
+    VM_SUB,
+    VM_MUL,
+    VM_DIV,
+    VM_DUP,
+    VM_SWAP,
+    VM_JMP,
+    VM_JZ,
+    VM_JNZ,
+    VM_BLOCK,
+
+    VM_OPCODES_COUNT
+};
+
+//-------------------------------------------------------------------------------------------
+//! Instruction of stack machine
+//!
+//! @note value is operand of VM_PUSH, target is index of instruction for jumps. VM_JZ and
+//!       VM_JNZ pop the condition. Binary operations pop b, then a, and push a op b
+//!       VM_BLOCK is put by VmProgramCtor only, its target is index of block
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct VmInstr {
+    VmOpcode opcode;
+    int32_t target;
+
+    T value;
+};
+
+//-------------------------------------------------------------------------------------------
+//! What basic block needs from stack
+//!
+//! @note minSize elements must be in stack at entry, size grows at most by maxGrowth inside
+//-------------------------------------------------------------------------------------------
+
+struct VmBlock {
+    int32_t minSize;
+    int32_t maxGrowth;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Checked program of stack machine
+//!
+//! @note Every basic block starts with VM_BLOCK, jumps go to these VM_BLOCK instructions
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct VmProgram {
+    VmInstr<T>* code;
+    int32_t size;
+
+    VmBlock* blocks;
+    int32_t blocksCount;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Checks bytecode, splits it in basic blocks and counts their stack bounds
+//!
+//! @param [out] program Pointer to the program which will be created
+//! @param [in]  code Array of instructions, VM_HALT is added after the last one
+//! @param [in]  size Amount of instructions
+//!
+//! @return 0 if no errors, PROGRAM_INVALID if opcode or jump target is wrong
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t VmProgramCtor(VmProgram<T>* program, const VmInstr<T>* code, int32_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Frees memory of program
+//!
+//! @param [in] program Pointer to the program
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void VmProgramDtor(VmProgram<T>* program);
+
+//-------------------------------------------------------------------------------------------
+//! Executes program on stack data
+//!
+//! @param [in] stack Pointer to the operand stack
+//! @param [in] program Pointer to the program
+//!
+//! @return NO_ERROR if VM_HALT was reached, STACK_UNDERFLOW if block needs more elements
+//!         than stack has, DIVISION_BY_ZERO for integer division by zero,
+//!         DIVISION_OVERFLOW for division of minimal signed integer by -1
+//!
+//! @note Stack is checked at start and end only (StackVerifyScope). Dispatch uses computed
+//!       goto if STACK_VM_COMPUTED_GOTO (default with GCC and clang) and switch otherwise
+//!       Top element is kept in register and written through, so binary operation loads
+//!       one operand. Bounds are checked once at entry of every block, stack grows there
+//!       if block may overflow it
+//!       On error stack keeps elements which it had when error was found
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+StackError VmRun(STACK_TYPE* stack, const VmProgram<T>* program);
+
+//-------------------------------------------------------------------------------------------
+//! Gets how instruction changes stack
+//!
+//! @param [in]  opcode Opcode of instruction
+//! @param [out] popped Amount of elements which instruction needs
+//!
+//! @return Change of stack size
+//-------------------------------------------------------------------------------------------
+
+int32_t GetVmStackEffect(VmOpcode opcode, int32_t* popped);
+
+//-------------------------------------------------------------------------------------------
+//! Checks if instruction is jump
+//-------------------------------------------------------------------------------------------
+
+inline bool IsVmJump(VmOpcode opcode) {
+    return opcode == VM_JMP || opcode == VM_JZ || opcode == VM_JNZ;
+}
+
+//-------------------------------------------------------------------------------------------
+//! Grows stack data for block in VmRun
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] size Current size, stack->size is set to it
+//! @param [in] needCapacity Capacity which block needs
+//! @param [in] usedSize Size under which cells may be not poisoned
+//-------------------------------------------------------------------------------------------
+
+STACK_TEMPLATE
+void VmGrowStack(STACK_TYPE* stack, int32_t size, int32_t needCapacity, int32_t usedSize);
+
+#include "stack_vm_impl.h"
+
+#endif
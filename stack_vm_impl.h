@@ -0,0 +1,297 @@
+#ifndef _STACK_VM_IMPL_H_
+#define _STACK_VM_IMPL_H_
+
+template <typename T>
+int32_t VmProgramCtor(VmProgram<T>* program, const VmInstr<T>* code, int32_t size) {
+    assert(program != nullptr              && "PROGRAM_NULL");
+    assert((code != nullptr || size == 0)  && "CODE_NULL");
+    assert(size >= 0                       && "NEGATIVE_SIZE");
+
+    *program = {};
+
+    bool* isLeader = (bool*)calloc(size + 1, sizeof(bool));
+    assert(isLeader != nullptr && "MEMORY_ERR");
+
+    isLeader[0] = true;
+
+    for (int32_t curInstr = 0; curInstr < size; curInstr++) {
+        VmOpcode opcode = code[curInstr].opcode;
+
+        if (opcode >= VM_BLOCK) {
+            free(isLeader);
+            return PROGRAM_INVALID;
+        }
+
+        if (IsVmJump(opcode)) {
+            int32_t target = code[curInstr].target;
+
+            if (target < 0 || target > size) {
+                free(isLeader);
+                return PROGRAM_INVALID;
+            }
+
+            isLeader[target] = true;
+        }
+
+        if (IsVmJump(opcode) || opcode == VM_HALT)
+            isLeader[curInstr + 1] = true;
+    }
+
+    // Instruction size is the added VM_HALT, every leader gets VM_BLOCK before it
+    int32_t* newIdx = (int32_t*)calloc(size + 1, sizeof(int32_t));
+    assert(newIdx != nullptr && "MEMORY_ERR");
+
+    int32_t blocksCount = 0;
+    for (int32_t curInstr = 0; curInstr <= size; curInstr++) {
+        if (isLeader[curInstr]) blocksCount++;
+        newIdx[curInstr] = curInstr + blocksCount;
+    }
+
+    program->size        = size + 1 + blocksCount;
+    program->blocksCount = blocksCount;
+    program->code        = (VmInstr<T>*)calloc(program->size, sizeof(VmInstr<T>));
+    program->blocks      = (VmBlock*)   calloc(blocksCount,   sizeof(VmBlock));
+    assert(program->code != nullptr && program->blocks != nullptr && "MEMORY_ERR");
+
+    VmInstr<T>* curCode  = program->code;
+    VmBlock*    block    = nullptr;
+    int32_t     curBlock = 0;
+    int32_t     depth    = 0;
+
+    for (int32_t curInstr = 0; curInstr <= size; curInstr++) {
+        if (isLeader[curInstr]) {
+            block = &program->blocks[curBlock];
+            depth = 0;
+
+            *curCode++ = { VM_BLOCK, curBlock++, {} };
+        }
+
+        VmInstr<T> instr = (curInstr < size) ? code[curInstr] : VmInstr<T>{ VM_HALT, 0, {} };
+        if (IsVmJump(instr.opcode))
+            instr.target = newIdx[instr.target] - 1;
+
+        int32_t popped = 0;
+        int32_t effect = GetVmStackEffect(instr.opcode, &popped);
+
+        if (block->minSize   < popped - depth) block->minSize   = popped - depth;
+        depth += effect;
+        if (block->maxGrowth < depth)          block->maxGrowth = depth;
+
+        *curCode++ = instr;
+    }
+
+    free(newIdx);
+    free(isLeader);
+
+    return 0;
+}
+
+template <typename T>
+void VmProgramDtor(VmProgram<T>* program) {
+    assert(program != nullptr && "PROGRAM_NULL");
+
+    free(program->code);
+    free(program->blocks);
+
+    *program = {};
+}
+
+STACK_TEMPLATE
+void VmGrowStack(STACK_TYPE* stack, int32_t size, int32_t needCapacity, int32_t usedSize) {
+    stack->size = size;
+    StackFillPoison(stack, size, usedSize);
+
+    // StackResize checks data hash, VmRun doesn't keep it
+    if (StackLevel(stack) >= HIGH_LEVEL)
+        WriteAllStackHash(stack);
+
+    int32_t newCapacity = (int32_t)(stack->capacity * stack->policy.increaseMultiplier);
+    if (newCapacity < needCapacity) newCapacity = needCapacity;
+
+    StatsAdd(stack, increases, 1);
+
+    stack->data = StackResize(stack, newCapacity);
+}
+
+STACK_TEMPLATE
+StackError VmRun(STACK_TYPE* stack, const VmProgram<T>* program) {
+    static_assert(std::is_arithmetic<T>::value, "Stack machine works with numbers only");
+    assert(program != nullptr && "PROGRAM_NULL");
+
+    StackVerifyScope<T, Level, InlineCapacity> scope(stack);
+
+    const VmInstr<T>* instr = program->code;
+    StackError error = NO_ERROR;
+
+    T* base      = (T*)stack->data;
+    T* top       = base + stack->size - 1;
+    T  topValue  = (stack->size > 0) ? *top : T();
+
+    int32_t usedSize = stack->size;
+
+    #if (STACK_VM_COMPUTED_GOTO)
+        static const void* const DISPATCH_TABLE[VM_OPCODES_COUNT] = {
+            &&VM_LABEL_VM_HALT, &&VM_LABEL_VM_PUSH, &&VM_LABEL_VM_POP,  &&VM_LABEL_VM_ADD,
+            &&VM_LABEL_VM_SUB,  &&VM_LABEL_VM_MUL,  &&VM_LABEL_VM_DIV,  &&VM_LABEL_VM_DUP,
+            &&VM_LABEL_VM_SWAP, &&VM_LABEL_VM_JMP,  &&VM_LABEL_VM_JZ,   &&VM_LABEL_VM_JNZ,
+            &&VM_LABEL_VM_BLOCK
+        };
+
+        #define VmCase(opcode) VM_LABEL_##opcode:
+        #define VmNext()       goto *DISPATCH_TABLE[(++instr)->opcode]
+        #define VmJump(index)  instr = program->code + (index); goto *DISPATCH_TABLE[instr->opcode]
+
+        goto *DISPATCH_TABLE[instr->opcode];
+    #else
+        #define VmCase(opcode) case opcode:
+        #define VmNext()       instr++; continue
+        #define VmJump(index)  instr = program->code + (index); continue
+
+        while (true) switch (instr->opcode) {
+    #endif
+
+    VmCase(VM_BLOCK) {
+        const VmBlock* block = &program->blocks[instr->target];
+        int32_t size = (int32_t)(top - base + 1);
+
+        if (size < block->minSize) {
+            error = STACK_UNDERFLOW;
+            goto vmEnd;
+        }
+
+        if (size + block->maxGrowth > stack->capacity) {
+            VmGrowStack(stack, size, size + block->maxGrowth, usedSize);
+
+            base     = (T*)stack->data;
+            top      = base + size - 1;
+            usedSize = size;
+        }
+
+        if (usedSize < size + block->maxGrowth) usedSize = size + block->maxGrowth;
+
+        VmNext();
+    }
+
+    VmCase(VM_PUSH) {
+        topValue = instr->value;
+        *++top   = topValue;
+
+        VmNext();
+    }
+
+    VmCase(VM_POP) {
+        if (--top >= base) topValue = *top;
+
+        VmNext();
+    }
+
+    VmCase(VM_ADD) {
+        --top;
+        topValue = *top + topValue;
+        *top     = topValue;
+
+        VmNext();
+    }
+
+    VmCase(VM_SUB) {
+        --top;
+        topValue = *top - topValue;
+        *top     = topValue;
+
+        VmNext();
+    }
+
+    VmCase(VM_MUL) {
+        --top;
+        topValue = *top * topValue;
+        *top     = topValue;
+
+        VmNext();
+    }
+
+    VmCase(VM_DIV) {
+        if (std::is_integral<T>::value && topValue == (T)0) {
+            error = DIVISION_BY_ZERO;
+            goto vmEnd;
+        }
+
+        if (std::is_signed<T>::value && std::is_integral<T>::value && topValue == (T)-1 &&
+            *(top - 1) == std::numeric_limits<T>::min()) {
+            error = DIVISION_OVERFLOW;
+            goto vmEnd;
+        }
+
+        --top;
+        topValue = *top / topValue;
+        *top     = topValue;
+
+        VmNext();
+    }
+
+    VmCase(VM_DUP) {
+        *++top = topValue;
+
+        VmNext();
+    }
+
+    VmCase(VM_SWAP) {
+        T second = top[-1];
+
+        top[-1]  = topValue;
+        *top     = second;
+        topValue = second;
+
+        VmNext();
+    }
+
+    VmCase(VM_JMP) {
+        VmJump(instr->target);
+    }
+
+    VmCase(VM_JZ) {
+        T condition = topValue;
+        if (--top >= base) topValue = *top;
+
+        if (condition == (T)0) {
+            VmJump(instr->target);
+        }
+
+        VmNext();
+    }
+
+    VmCase(VM_JNZ) {
+        T condition = topValue;
+        if (--top >= base) topValue = *top;
+
+        if (condition != (T)0) {
+            VmJump(instr->target);
+        }
+
+        VmNext();
+    }
+
+    VmCase(VM_HALT) {
+        goto vmEnd;
+    }
+
+    #if (!STACK_VM_COMPUTED_GOTO)
+        default:
+            error = PROGRAM_INVALID;
+            goto vmEnd;
+        }
+    #endif
+
+    #undef VmCase
+    #undef VmNext
+    #undef VmJump
+
+vmEnd:
+    stack->size = (int32_t)(top - base + 1);
+    if (stack->size > stack->peakSize) stack->peakSize = stack->size;
+
+    StackFillPoison(stack, stack->size, usedSize);
+
+    return error;
+}
+
+#endif
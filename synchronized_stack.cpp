@@ -0,0 +1,68 @@
+#ifdef __linux__
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#else
+    #include <thread>
+#endif
+
+#include "synchronized_stack.h"
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex needs plain word");
+
+//-------------------------------------------------------------------------------------------
+//! Sleeps while lock state is LOCK_WAITED
+//!
+//! @param [in] lock Pointer to the lock
+//!
+//! @note Without futex thread gives its time slice away
+//-------------------------------------------------------------------------------------------
+
+static void StackLockSleep(StackLock* lock) {
+    #ifdef __linux__
+        syscall(SYS_futex, (uint32_t*)&lock->state, FUTEX_WAIT_PRIVATE, LOCK_WAITED,
+                nullptr, nullptr, 0);
+    #else
+        (void)lock;
+        std::this_thread::yield();
+    #endif
+}
+
+void StackLockAcquireSlow(StackLock* lock) {
+    assert(lock != nullptr && "LOCK_NULL");
+
+    uint32_t spinLimit = lock->spinLimit.load(std::memory_order_relaxed);
+
+    for (uint32_t curSpin = 0; curSpin < spinLimit; curSpin++) {
+        SpinWait(1);
+
+        if (lock->state.load(std::memory_order_relaxed) == LOCK_FREE && StackLockTry(lock)) {
+            // Limit goes to twice the spins which were enough
+            int32_t newLimit = (int32_t)spinLimit + (2 * (int32_t)curSpin - (int32_t)spinLimit) / 8;
+            if (newLimit < (int32_t)LOCK_MIN_SPINS) newLimit = LOCK_MIN_SPINS;
+            if (newLimit > (int32_t)LOCK_MAX_SPINS) newLimit = LOCK_MAX_SPINS;
+
+            lock->spinLimit.store((uint32_t)newLimit, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    uint32_t newLimit = spinLimit - spinLimit / 8;
+    if (newLimit < LOCK_MIN_SPINS) newLimit = LOCK_MIN_SPINS;
+
+    lock->spinLimit.store(newLimit, std::memory_order_relaxed);
+
+    // LOCK_WAITED is kept after wake up, because other threads may still sleep
+    while (lock->state.exchange(LOCK_WAITED, std::memory_order_acquire) != LOCK_FREE)
+        StackLockSleep(lock);
+}
+
+void StackLockWake(StackLock* lock) {
+    assert(lock != nullptr && "LOCK_NULL");
+
+    #ifdef __linux__
+        syscall(SYS_futex, (uint32_t*)&lock->state, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    #else
+        (void)lock;
+    #endif
+}
@@ -0,0 +1,335 @@
+#ifndef _SYNCHRONIZED_STACK_H_
+#define _SYNCHRONIZED_STACK_H_
+
+#include "concurrent_stack.h"
+
+#define SynchronizedStackCtor(stack, type)         \
+    SynchronizedStack<type> stack = {};            \
+    SynchronizedStackCtor_(&stack LOCATION (stack));
+
+const uint32_t LOCK_MIN_SPINS          = 16;
+const uint32_t LOCK_MAX_SPINS          = 4096;
+
+const uint32_t COMBINING_RECORDS_COUNT = 64;
+const uint32_t COMBINING_PROBES        = 4;
+const uint32_t COMBINING_PASSES        = 2;
+const uint32_t COMBINING_WAIT_SPINS    = 256;
+
+enum StackLockState {
+    LOCK_FREE    = 0,
+    LOCK_TAKEN   = 1,
+    LOCK_WAITED  = 2,
+};
+
+enum CombiningState {
+    COMBINING_EMPTY   = 0,
+    COMBINING_WRITING = 1,
+    COMBINING_PUSH    = 2,
+    COMBINING_POP     = 3,
+    COMBINING_DONE    = 4,
+};
+
+//-------------------------------------------------------------------------------------------
+//! Lock which spins some time and then sleeps on futex
+//!
+//! @note state is one of StackLockState, LOCK_WAITED means that somebody may sleep, so
+//!       release has to wake a sleeper. spinLimit is amount of spins before sleep, it grows
+//!       when spinning gets lock and shrinks when it doesn't
+//-------------------------------------------------------------------------------------------
+
+struct StackLock {
+    std::atomic<uint32_t> state;
+    std::atomic<uint32_t> spinLimit;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Request of one thread for flat combining
+//!
+//! @note state is one of CombiningState. Owner thread moves it from COMBINING_EMPTY to
+//!       COMBINING_WRITING, writes value and publishes COMBINING_PUSH or COMBINING_POP.
+//!       Combiner applies request, writes result and value and publishes COMBINING_DONE,
+//!       then owner reads them and frees record
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct alignas(CACHE_LINE_SIZE) CombiningRecord {
+    std::atomic<uint32_t> state;
+    int32_t result;
+
+    T value;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Stack of T elements which can be used from several threads
+//!
+//! @note Every operation is done on stack under lock with all checks of its level.
+//!       SynchronizedStackPush and SynchronizedStackPop take lock for one operation,
+//!       combining versions put request in records and thread which gets lock applies all
+//!       requests in one StackVerifyScope, so stack is checked and its hashes are written
+//!       once per batch
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct SynchronizedStack {
+    typedef T Elem;
+
+    canary canaryLeft;
+
+    VarInfo creationInfo;
+
+    alignas(CACHE_LINE_SIZE) StackLock lock;
+
+    alignas(CACHE_LINE_SIZE) Stack<T> stack;
+
+    CombiningRecord<T> records[COMBINING_RECORDS_COUNT];
+
+    alignas(CACHE_LINE_SIZE) canary canaryRight;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Creates synchronized stack from SynchronizedStackCtor macro
+//!
+//! @param [in] stack Pointer to the stack structure which will be created
+//! @param [in] policy Growth policy of stack
+//! @param [in] allocator Source of data memory
+//!
+//! @return 0 if no errors
+//!
+//! @note Constructor and destructor are not thread-safe
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t SynchronizedStackCtor_(SynchronizedStack<T>* stack, VarInfo creationInfo,
+                               GrowthPolicy policy = DEFAULT_GROWTH_POLICY,
+                               StackAllocator allocator = MALLOC_ALLOCATOR);
+
+//-------------------------------------------------------------------------------------------
+//! Destroys synchronized stack
+//!
+//! @param [in] stack Pointer to the stack which will be destroyed
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t SynchronizedStackDtor(SynchronizedStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Pushes element with StackPush under lock
+//!
+//! @param [in] stack Pointer to the stack where element will be pushed
+//! @param [in] pushedValue Element which will be pushed
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t SynchronizedStackPush(SynchronizedStack<T>* stack,
+                              typename SynchronizedStack<T>::Elem pushedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Pops element with StackPop under lock
+//!
+//! @param [in]  stack Pointer to the stack where from element will be popped
+//! @param [out] poppedValue Pointer to the popped value
+//!
+//! @return 0 if element was popped, STACK_UNDERFLOW if stack was empty
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t SynchronizedStackPop(SynchronizedStack<T>* stack, T* poppedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Pushes element with flat combining
+//!
+//! @param [in] stack Pointer to the stack where element will be pushed
+//! @param [in] pushedValue Element which will be pushed
+//!
+//! @return 0 if no errors
+//!
+//! @note If thread finds no free record, it pushes with SynchronizedStackPush
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t SynchronizedStackCombinePush(SynchronizedStack<T>* stack,
+                                     typename SynchronizedStack<T>::Elem pushedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Pops element with flat combining
+//!
+//! @param [in]  stack Pointer to the stack where from element will be popped
+//! @param [out] poppedValue Pointer to the popped value
+//!
+//! @return 0 if element was popped, STACK_UNDERFLOW if stack was empty
+//!
+//! @note If thread finds no free record, it pops with SynchronizedStackPop
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t SynchronizedStackCombinePop(SynchronizedStack<T>* stack, T* poppedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Puts request in record and waits until some combiner applies it
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] record Pointer to the record in COMBINING_WRITING state
+//! @param [in] request COMBINING_PUSH or COMBINING_POP
+//! @param [in, out] value Pointer to the pushed value or to the popped value
+//!
+//! @return Result of operation
+//!
+//! @note Thread spins while lock is busy and becomes combiner when it gets lock, after
+//!       COMBINING_WAIT_SPINS spins it sleeps on lock
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t SynchronizedStackCombine(SynchronizedStack<T>* stack, CombiningRecord<T>* record,
+                                 CombiningState request, T* value);
+
+//-------------------------------------------------------------------------------------------
+//! Applies all published requests, must be called under lock
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @note Requests are applied with StackPushFast and StackPopFast inside one StackVerifyScope,
+//!       single request is applied with StackPush or StackPop
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+void SynchronizedStackApply(SynchronizedStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Applies request of one record if it is published
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] record Pointer to the record
+//! @param [in] isInScope true if stack is in StackVerifyScope
+//!
+//! @return true if request was applied
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+bool SynchronizedStackApplyRecord(SynchronizedStack<T>* stack, CombiningRecord<T>* record,
+                                  bool isInScope);
+
+//-------------------------------------------------------------------------------------------
+//! Takes free record of current thread
+//!
+//! @param [in] stack Pointer to the stack
+//!
+//! @return Pointer to the record in COMBINING_WRITING state, nullptr if records near
+//!         thread slot are busy
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+CombiningRecord<T>* TakeCombiningRecord(SynchronizedStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Checks synchronized stack and its stack as IsAllOk checks Stack
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return One of StackError
+//!
+//! @note Should be called when no thread changes stack, push and pop check structure only,
+//!       stack is checked by its own functions
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+StackError IsAllOk(SynchronizedStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Checks canaries of synchronized stack structure
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return One of StackError
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+StackError IsSynchronizedStructOk(SynchronizedStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Writes full synchronized stack dump in outstream
+//!
+//! @param [in] stack Pointer to the stack which will be dumped
+//! @param [in] outstream Pointer to the stream where dump will be written (default is stdout)
+//!
+//! @return 0 if all OK
+//!
+//! @note Elements are listed only if no thread changes stack during dump
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int StackDump(SynchronizedStack<T>* stack, VarInfo dumpInfo, FILE* outstream = stdout);
+
+//-------------------------------------------------------------------------------------------
+//! Takes lock, sleeps if spinning doesn't help
+//!
+//! @param [in] lock Pointer to the lock
+//-------------------------------------------------------------------------------------------
+
+void StackLockAcquireSlow(StackLock* lock);
+
+//-------------------------------------------------------------------------------------------
+//! Wakes one thread which sleeps on lock
+//!
+//! @param [in] lock Pointer to the lock
+//-------------------------------------------------------------------------------------------
+
+void StackLockWake(StackLock* lock);
+
+//-------------------------------------------------------------------------------------------
+//! Tries to take lock once
+//!
+//! @param [in] lock Pointer to the lock
+//!
+//! @return true if lock was taken
+//-------------------------------------------------------------------------------------------
+
+inline bool StackLockTry(StackLock* lock) {
+    uint32_t expected = LOCK_FREE;
+
+    return lock->state.compare_exchange_strong(expected, LOCK_TAKEN, std::memory_order_acquire,
+                                                                     std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Takes lock
+//!
+//! @param [in] lock Pointer to the lock
+//-------------------------------------------------------------------------------------------
+
+inline void StackLockAcquire(StackLock* lock) {
+    if (!StackLockTry(lock))
+        StackLockAcquireSlow(lock);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Releases lock, system call is made only if somebody may sleep
+//!
+//! @param [in] lock Pointer to the lock
+//-------------------------------------------------------------------------------------------
+
+inline void StackLockRelease(StackLock* lock) {
+    if (lock->state.exchange(LOCK_FREE, std::memory_order_release) == LOCK_WAITED)
+        StackLockWake(lock);
+}
+
+//-------------------------------------------------------------------------------------------
+//! Gets record slot of current thread
+//!
+//! @return Index of record where thread starts to look for free one
+//-------------------------------------------------------------------------------------------
+
+inline uint32_t GetCombiningSlot() {
+    static std::atomic<uint32_t> nextSlot = {};
+    static thread_local uint32_t threadSlot =
+        nextSlot.fetch_add(1, std::memory_order_relaxed) % COMBINING_RECORDS_COUNT;
+
+    return threadSlot;
+}
+
+#include "synchronized_stack_impl.h"
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef _SYNCHRONIZED_STACK_IMPL_H_
+#define _SYNCHRONIZED_STACK_IMPL_H_
+
+template <typename T>
+int32_t SynchronizedStackCtor_(SynchronizedStack<T>* stack, VarInfo creationInfo,
+                               GrowthPolicy policy, StackAllocator allocator) {
+    assert(stack != nullptr && "STACK_NULL");
+
+    stack->canaryLeft   = CANARY;
+    stack->canaryRight  = CANARY;
+
+    stack->creationInfo = creationInfo;
+
+    stack->lock.state.store(LOCK_FREE, std::memory_order_relaxed);
+    stack->lock.spinLimit.store(LOCK_MIN_SPINS, std::memory_order_relaxed);
+
+    for (uint32_t curRecord = 0; curRecord < COMBINING_RECORDS_COUNT; curRecord++) {
+        stack->records[curRecord].state.store(COMBINING_EMPTY, std::memory_order_relaxed);
+    }
+
+    return StackCtor_(&stack->stack, creationInfo, policy, STACK_DEBUG, allocator);
+}
+
+template <typename T>
+int32_t SynchronizedStackDtor(SynchronizedStack<T>* stack) {
+    CheckStack(stack, IsAllOk);
+
+    for (uint32_t curRecord = 0; curRecord < COMBINING_RECORDS_COUNT; curRecord++) {
+        assert(stack->records[curRecord].state.load(std::memory_order_acquire) == COMBINING_EMPTY &&
+               "REQUEST_PENDING");
+    }
+
+    return StackDtor(&stack->stack);
+}
+
+template <typename T>
+int32_t SynchronizedStackPush(SynchronizedStack<T>* stack,
+                              typename SynchronizedStack<T>::Elem pushedValue) {
+    CheckStack(stack, IsSynchronizedStructOk);
+
+    StackLockAcquire(&stack->lock);
+    int32_t error = StackPush(&stack->stack, pushedValue);
+    StackLockRelease(&stack->lock);
+
+    return error;
+}
+
+template <typename T>
+int32_t SynchronizedStackPop(SynchronizedStack<T>* stack, T* poppedValue) {
+    CheckStack(stack, IsSynchronizedStructOk);
+    assert(poppedValue != nullptr && "VALUE_NULL");
+
+    int32_t error = NO_ERROR;
+
+    StackLockAcquire(&stack->lock);
+
+    if (stack->stack.size == 0)
+        error = STACK_UNDERFLOW;
+    else
+        *poppedValue = StackPop(&stack->stack);
+
+    StackLockRelease(&stack->lock);
+
+    return error;
+}
+
+template <typename T>
+int32_t SynchronizedStackCombinePush(SynchronizedStack<T>* stack,
+                                     typename SynchronizedStack<T>::Elem pushedValue) {
+    CheckStack(stack, IsSynchronizedStructOk);
+
+    CombiningRecord<T>* record = TakeCombiningRecord(stack);
+    if (record == nullptr) return SynchronizedStackPush(stack, pushedValue);
+
+    return SynchronizedStackCombine(stack, record, COMBINING_PUSH, &pushedValue);
+}
+
+template <typename T>
+int32_t SynchronizedStackCombinePop(SynchronizedStack<T>* stack, T* poppedValue) {
+    CheckStack(stack, IsSynchronizedStructOk);
+    assert(poppedValue != nullptr && "VALUE_NULL");
+
+    CombiningRecord<T>* record = TakeCombiningRecord(stack);
+    if (record == nullptr) return SynchronizedStackPop(stack, poppedValue);
+
+    return SynchronizedStackCombine(stack, record, COMBINING_POP, poppedValue);
+}
+
+template <typename T>
+int32_t SynchronizedStackCombine(SynchronizedStack<T>* stack, CombiningRecord<T>* record,
+                                 CombiningState request, T* value) {
+    record->value = *value;
+    record->state.store(request, std::memory_order_release);
+
+    uint32_t spins = 0;
+    while (record->state.load(std::memory_order_acquire) != COMBINING_DONE) {
+        if (StackLockTry(&stack->lock)) {
+            SynchronizedStackApply(stack);
+            StackLockRelease(&stack->lock);
+
+            continue;
+        }
+
+        if (spins < COMBINING_WAIT_SPINS) {
+            SpinWait(1);
+            spins++;
+
+            continue;
+        }
+
+        StackLockAcquire(&stack->lock);
+
+        if (record->state.load(std::memory_order_acquire) != COMBINING_DONE)
+            SynchronizedStackApply(stack);
+
+        StackLockRelease(&stack->lock);
+    }
+
+    int32_t result = record->result;
+    *value         = record->value;
+
+    record->state.store(COMBINING_EMPTY, std::memory_order_release);
+
+    return result;
+}
+
+template <typename T>
+void SynchronizedStackApply(SynchronizedStack<T>* stack) {
+    CombiningRecord<T>* lastRecord = nullptr;
+    uint32_t requestsCount = 0;
+
+    for (uint32_t curRecord = 0; curRecord < COMBINING_RECORDS_COUNT; curRecord++) {
+        uint32_t request = stack->records[curRecord].state.load(std::memory_order_relaxed);
+
+        if (request == COMBINING_PUSH || request == COMBINING_POP) {
+            lastRecord = &stack->records[curRecord];
+            requestsCount++;
+        }
+    }
+
+    if (requestsCount == 0) return;
+
+    // Scope checks whole stack twice, so single request is cheaper with usual functions
+    if (requestsCount == 1) {
+        SynchronizedStackApplyRecord(stack, lastRecord, false);
+        return;
+    }
+
+    StackVerifyScope scope(&stack->stack);
+
+    for (uint32_t curPass = 0; curPass < COMBINING_PASSES; curPass++) {
+        bool isApplied = false;
+
+        for (uint32_t curRecord = 0; curRecord < COMBINING_RECORDS_COUNT; curRecord++) {
+            isApplied |= SynchronizedStackApplyRecord(stack, &stack->records[curRecord], true);
+        }
+
+        if (!isApplied) break;
+    }
+}
+
+template <typename T>
+bool SynchronizedStackApplyRecord(SynchronizedStack<T>* stack, CombiningRecord<T>* record,
+                                  bool isInScope) {
+    uint32_t request = record->state.load(std::memory_order_acquire);
+
+    if (request == COMBINING_PUSH) {
+        if (isInScope)
+            StackPushFast(&stack->stack, record->value);
+        else
+            StackPush(&stack->stack, record->value);
+
+        record->result = NO_ERROR;
+    }
+    else if (request == COMBINING_POP) {
+        if (stack->stack.size == 0) {
+            record->result = STACK_UNDERFLOW;
+        }
+        else {
+            record->value  = isInScope ? StackPopFast(&stack->stack) : StackPop(&stack->stack);
+            record->result = NO_ERROR;
+        }
+    }
+    else {
+        return false;
+    }
+
+    record->state.store(COMBINING_DONE, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+CombiningRecord<T>* TakeCombiningRecord(SynchronizedStack<T>* stack) {
+    uint32_t slot = GetCombiningSlot();
+
+    for (uint32_t curProbe = 0; curProbe < COMBINING_PROBES; curProbe++) {
+        CombiningRecord<T>* record = &stack->records[(slot + curProbe) % COMBINING_RECORDS_COUNT];
+
+        uint32_t expected = COMBINING_EMPTY;
+        if (record->state.load(std::memory_order_relaxed) == COMBINING_EMPTY &&
+            record->state.compare_exchange_strong(expected, COMBINING_WRITING,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed))
+            return record;
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+StackError IsAllOk(SynchronizedStack<T>* stack) {
+    if (StackError error = IsSynchronizedStructOk(stack)) return error;
+
+    return IsAllOk(&stack->stack);
+}
+
+template <typename T>
+StackError IsSynchronizedStructOk(SynchronizedStack<T>* stack) {
+    if (stack == nullptr)              return STACK_NULL;
+    if (stack->canaryLeft  != CANARY)  return LEFT_STACK_CANARY_IRRUPTION;
+    if (stack->canaryRight != CANARY)  return RIGHT_STACK_CANARY_IRRUPTION;
+
+    return NO_ERROR;
+}
+
+template <typename T>
+int StackDump(SynchronizedStack<T>* stack, VarInfo dumpInfo, FILE* outstream) {
+    DumpBuffer buffer = {};
+    DumpBufferCtor(&buffer);
+
+    DumpPrintf(&buffer, "Dump from %s() at %s(%d) in stack called now \"%s\": IsAllOk() %s\n",
+               dumpInfo.function, dumpInfo.file, dumpInfo.line, dumpInfo.name,
+               ErrorToString(IsAllOk(stack)));
+
+    if (stack == nullptr) return DumpFinish(&buffer, outstream);
+
+    DumpPrintf(&buffer, "synchronized stack <%s> [%p] \"%s\" ",
+               StackElemInfo<T>::NAME, stack, stack->creationInfo.name);
+    DumpPrintf(&buffer, "from %s (%d), %s(): {\n",
+               stack->creationInfo.file,  stack->creationInfo.line, stack->creationInfo.function);
+
+    DumpPrintf(&buffer, "lock      = %u\n",   stack->lock.state.load(std::memory_order_acquire));
+    DumpPrintf(&buffer, "spinLimit = %u\n\n", stack->lock.spinLimit.load(std::memory_order_relaxed));
+
+    DumpPrintf(&buffer, "Stack canaries:\n");
+    DumpPrintf(&buffer, "    canaryLeft[%p] = %ud (%s)\n",
+               &stack->canaryLeft,  stack->canaryLeft,  (stack->canaryLeft  == CANARY) ?
+               "Ok" : "IRRUPTION");
+    DumpPrintf(&buffer, "    canaryRight[%p] = %ud (%s)\n\n",
+               &stack->canaryRight, stack->canaryRight, (stack->canaryRight == CANARY) ?
+               "Ok" : "IRRUPTION");
+
+    DumpPrintf(&buffer, "Pending requests:\n");
+    for (uint32_t curRecord = 0; curRecord < COMBINING_RECORDS_COUNT; curRecord++) {
+        uint32_t request = stack->records[curRecord].state.load(std::memory_order_acquire);
+
+        if (request != COMBINING_EMPTY)
+            DumpPrintf(&buffer, "    records[%u] state = %u\n", curRecord, request);
+    }
+
+    DumpPrintf(&buffer, "}\n");
+
+    int32_t error = DumpFinish(&buffer, outstream);
+    if (error) return error;
+
+    return StackDump(&stack->stack, dumpInfo, outstream);
+}
+
+#endif
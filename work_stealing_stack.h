@@ -0,0 +1,180 @@
+#ifndef _WORK_STEALING_STACK_H_
+#define _WORK_STEALING_STACK_H_
+
+#include "concurrent_stack.h"
+
+#define WorkStealingCtor(stack, type)              \
+    WorkStealingStack<type> stack = {};            \
+    WorkStealingCtor_(&stack LOCATION (stack));
+
+const int64_t WORK_STEALING_BEGINNING_CAPACITY = 64;
+
+//-------------------------------------------------------------------------------------------
+//! Circular array of work stealing stack, element i lives in data[i & (capacity - 1)]
+//!
+//! @note Block is header, left canary, capacity elements and right canary. Replaced arrays
+//!       are kept in retired list until destructor because thieves may still read them
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct WorkStealingArray {
+    int64_t capacity;
+    uint8_t* data;
+
+    WorkStealingArray<T>* retired;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Work stealing stack (Chase-Lev deque) of T elements
+//!
+//! @note Owner thread pushes and pops at size, other threads steal at bottom.
+//!       Elements are in [bottom, size). T must be trivially copyable: thief reads element
+//!       before its CAS, so it can read a slot which owner rewrites, but such value is
+//!       thrown away because CAS fails
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+struct WorkStealingStack {
+    typedef T Elem;
+
+    canary canaryLeft;
+
+    VarInfo creationInfo;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> size;
+    std::atomic<WorkStealingArray<T>*> array;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom;
+
+    alignas(CACHE_LINE_SIZE) canary canaryRight;
+};
+
+//-------------------------------------------------------------------------------------------
+//! Creates work stealing stack from WorkStealingCtor macro
+//!
+//! @param [in] stack Pointer to the stack structure which will be created
+//!
+//! @return 0 if no errors
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t WorkStealingCtor_(WorkStealingStack<T>* stack, VarInfo creationInfo);
+
+//-------------------------------------------------------------------------------------------
+//! Destroys work stealing stack and all its retired arrays
+//!
+//! @param [in] stack Pointer to the stack which will be destroyed
+//!
+//! @return 0 if no errors
+//!
+//! @note No thread may steal during destruction
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t WorkStealingDtor(WorkStealingStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Pushes element at the top, only owner thread may call it
+//!
+//! @param [in] stack Pointer to the stack where element will be pushed
+//! @param [in] pushedValue Element which will be pushed
+//!
+//! @return 0 if no errors
+//!
+//! @note Fast path has no read-modify-write operations, only release store of size
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t WorkStealingPush(WorkStealingStack<T>* stack, typename WorkStealingStack<T>::Elem pushedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Pops element from the top, only owner thread may call it
+//!
+//! @param [in]  stack Pointer to the stack where from element will be popped
+//! @param [out] poppedValue Pointer to the popped value
+//!
+//! @return 0 if element was popped, STACK_UNDERFLOW if stack was empty
+//!
+//! @note CAS is needed only when owner and thieves compete for the last element
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t WorkStealingPop(WorkStealingStack<T>* stack, T* poppedValue);
+
+//-------------------------------------------------------------------------------------------
+//! Steals element from the bottom, any thread may call it
+//!
+//! @param [in]  stack Pointer to the stack where from element will be stolen
+//! @param [out] stolenValue Pointer to the stolen value
+//!
+//! @return 0 if element was stolen, STACK_UNDERFLOW if stack was empty
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int32_t WorkStealingSteal(WorkStealingStack<T>* stack, T* stolenValue);
+
+//-------------------------------------------------------------------------------------------
+//! Replaces array with twice bigger one, only owner thread may call it
+//!
+//! @param [in] stack Pointer to the stack
+//! @param [in] bottom Current bottom of stack
+//! @param [in] size Current size of stack
+//!
+//! @return Pointer to the new array
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+WorkStealingArray<T>* WorkStealingGrow(WorkStealingStack<T>* stack, int64_t bottom, int64_t size);
+
+//-------------------------------------------------------------------------------------------
+//! Allocates array with canaries
+//!
+//! @param [in] capacity Capacity of array, power of two
+//!
+//! @return Pointer to the array
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+WorkStealingArray<T>* WorkStealingArrayCtor(int64_t capacity);
+
+//-------------------------------------------------------------------------------------------
+//! Gets element of array by its index in stack
+//!
+//! @param [in] array Pointer to the array
+//! @param [in] elemIdx Index of element in stack
+//!
+//! @return Pointer to the element
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+T* GetWorkStealingElem(WorkStealingArray<T>* array, int64_t elemIdx);
+
+//-------------------------------------------------------------------------------------------
+//! Checks work stealing stack as IsAllOk checks Stack
+//!
+//! @param [in] stack Pointer to the stack which will be checked
+//!
+//! @return One of StackError
+//!
+//! @note Should be called by owner thread, checks are done in push and pop if
+//!       STACK_DEBUG >= MID_LEVEL
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+StackError IsAllOk(WorkStealingStack<T>* stack);
+
+//-------------------------------------------------------------------------------------------
+//! Writes full work stealing stack dump in outstream
+//!
+//! @param [in] stack Pointer to the stack which will be dumped
+//! @param [in] outstream Pointer to the stream where dump will be written (default is stdout)
+//!
+//! @return 0 if all OK
+//-------------------------------------------------------------------------------------------
+
+template <typename T>
+int StackDump(WorkStealingStack<T>* stack, VarInfo dumpInfo, FILE* outstream = stdout);
+
+#include "work_stealing_stack_impl.h"
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef _WORK_STEALING_STACK_IMPL_H_
+#define _WORK_STEALING_STACK_IMPL_H_
+
+template <typename T>
+int32_t WorkStealingCtor_(WorkStealingStack<T>* stack, VarInfo creationInfo) {
+    assert(stack != nullptr && "STACK_NULL");
+
+    stack->canaryLeft   = CANARY;
+    stack->canaryRight  = CANARY;
+
+    stack->creationInfo = creationInfo;
+
+    stack->size.store(0, std::memory_order_relaxed);
+    stack->bottom.store(0, std::memory_order_relaxed);
+    stack->array.store(WorkStealingArrayCtor<T>(WORK_STEALING_BEGINNING_CAPACITY),
+                       std::memory_order_relaxed);
+
+    return 0;
+}
+
+template <typename T>
+int32_t WorkStealingDtor(WorkStealingStack<T>* stack) {
+    CheckStack(stack, IsAllOk);
+
+    WorkStealingArray<T>* curArray = stack->array.load(std::memory_order_relaxed);
+    while (curArray != nullptr) {
+        WorkStealingArray<T>* retiredArray = curArray->retired;
+        free(curArray);
+
+        curArray = retiredArray;
+    }
+
+    stack->array.store(nullptr, std::memory_order_relaxed);
+    stack->size.store(-1, std::memory_order_relaxed);
+
+    return 0;
+}
+
+template <typename T>
+int32_t WorkStealingPush(WorkStealingStack<T>* stack, typename WorkStealingStack<T>::Elem pushedValue) {
+    #if (STACK_DEBUG >= MID_LEVEL)
+        CheckStack(stack, IsAllOk);
+    #endif
+
+    int64_t size   = stack->size.load(std::memory_order_relaxed);
+    int64_t bottom = stack->bottom.load(std::memory_order_acquire);
+    WorkStealingArray<T>* array = stack->array.load(std::memory_order_relaxed);
+
+    if (size - bottom >= array->capacity)
+        array = WorkStealingGrow(stack, bottom, size);
+
+    *GetWorkStealingElem(array, size) = pushedValue;
+
+    stack->size.store(size + 1, std::memory_order_release);
+
+    return 0;
+}
+
+template <typename T>
+int32_t WorkStealingPop(WorkStealingStack<T>* stack, T* poppedValue) {
+    #if (STACK_DEBUG >= MID_LEVEL)
+        CheckStack(stack, IsAllOk);
+    #endif
+    assert(poppedValue != nullptr && "VALUE_NULL");
+
+    int64_t size = stack->size.load(std::memory_order_relaxed) - 1;
+    WorkStealingArray<T>* array = stack->array.load(std::memory_order_relaxed);
+
+    stack->size.store(size, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    int64_t bottom = stack->bottom.load(std::memory_order_relaxed);
+
+    if (bottom > size) {
+        stack->size.store(size + 1, std::memory_order_relaxed);
+
+        return STACK_UNDERFLOW;
+    }
+
+    *poppedValue = *GetWorkStealingElem(array, size);
+    if (bottom < size) return 0;
+
+    bool isTaken = stack->bottom.compare_exchange_strong(bottom, bottom + 1,
+                                                         std::memory_order_seq_cst,
+                                                         std::memory_order_relaxed);
+    stack->size.store(size + 1, std::memory_order_relaxed);
+
+    return isTaken ? 0 : STACK_UNDERFLOW;
+}
+
+template <typename T>
+int32_t WorkStealingSteal(WorkStealingStack<T>* stack, T* stolenValue) {
+    assert(stack       != nullptr && "STACK_NULL");
+    assert(stolenValue != nullptr && "VALUE_NULL");
+
+    uint32_t spins = 1;
+    while (true) {
+        int64_t bottom = stack->bottom.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t size   = stack->size.load(std::memory_order_acquire);
+
+        if (bottom >= size) return STACK_UNDERFLOW;
+
+        WorkStealingArray<T>* array = stack->array.load(std::memory_order_acquire);
+        T stolen = *GetWorkStealingElem(array, bottom);
+
+        if (stack->bottom.compare_exchange_strong(bottom, bottom + 1,
+                                                  std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed)) {
+            *stolenValue = stolen;
+            return 0;
+        }
+
+        SpinWait(spins);
+        if (spins < BACKOFF_MAX_SPINS) spins *= 2;
+    }
+}
+
+template <typename T>
+WorkStealingArray<T>* WorkStealingGrow(WorkStealingStack<T>* stack, int64_t bottom, int64_t size) {
+    WorkStealingArray<T>* oldArray = stack->array.load(std::memory_order_relaxed);
+    WorkStealingArray<T>* newArray = WorkStealingArrayCtor<T>(oldArray->capacity * 2);
+
+    for (int64_t curIdx = bottom; curIdx < size; curIdx++) {
+        *GetWorkStealingElem(newArray, curIdx) = *GetWorkStealingElem(oldArray, curIdx);
+    }
+
+    newArray->retired = oldArray;
+    stack->array.store(newArray, std::memory_order_release);
+
+    return newArray;
+}
+
+template <typename T>
+WorkStealingArray<T>* WorkStealingArrayCtor(int64_t capacity) {
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0 && "CAPACITY_INVALID");
+
+    uint64_t headerSize = (sizeof(WorkStealingArray<T>) + DATA_ALIGNMENT - 1) /
+                          DATA_ALIGNMENT * DATA_ALIGNMENT;
+    uint64_t shift      = GetShift(MID_LEVEL);
+
+    WorkStealingArray<T>* array = (WorkStealingArray<T>*)MallocAllocate(nullptr, headerSize +
+                                                                        capacity * sizeof(T) +
+                                                                        GetProtectionSize(MID_LEVEL));
+    assert(array != nullptr && "DATA_NULL");
+
+    array->capacity = capacity;
+    array->data     = (uint8_t*)array + headerSize + shift;
+    array->retired  = nullptr;
+
+    *(canary*)(array->data - shift)                 = CANARY;
+    *(canary*)(array->data + capacity * sizeof(T))  = CANARY;
+
+    return array;
+}
+
+template <typename T>
+T* GetWorkStealingElem(WorkStealingArray<T>* array, int64_t elemIdx) {
+    return (T*)(array->data + (elemIdx & (array->capacity - 1)) * sizeof(T));
+}
+
+template <typename T>
+StackError IsAllOk(WorkStealingStack<T>* stack) {
+    if (stack == nullptr)                                    return STACK_NULL;
+
+    int64_t size   = stack->size.load(std::memory_order_relaxed);
+    int64_t bottom = stack->bottom.load(std::memory_order_relaxed);
+    WorkStealingArray<T>* array = stack->array.load(std::memory_order_relaxed);
+
+    if (size == -1 && array == nullptr)                      return STACK_FREE;
+    if (array == nullptr)                                    return DATA_NULL;
+    if (array->capacity <= 0)                                return CAPACITY_NEGATIVE;
+
+    if (stack->canaryLeft  != CANARY)                        return LEFT_STACK_CANARY_IRRUPTION;
+    if (stack->canaryRight != CANARY)                        return RIGHT_STACK_CANARY_IRRUPTION;
+
+    if (*(canary*)(array->data - GetShift(MID_LEVEL)) != CANARY)
+                                                             return LEFT_DATA_CANARY_IRRUPTION;
+    if (*(canary*)(array->data + array->capacity * sizeof(T)) != CANARY)
+                                                             return RIGHT_DATA_CANARY_IRRUPTION;
+
+    if (size < bottom)                                       return STACK_UNDERFLOW;
+    if (size - bottom > array->capacity)                     return STACK_OVERFLOW;
+
+    return NO_ERROR;
+}
+
+template <typename T>
+int StackDump(WorkStealingStack<T>* stack, VarInfo dumpInfo, FILE* outstream) {
+    DumpBuffer buffer = {};
+    DumpBufferCtor(&buffer);
+
+    DumpPrintf(&buffer, "Dump from %s() at %s(%d) in stack called now \"%s\": IsAllOk() %s\n",
+               dumpInfo.function, dumpInfo.file, dumpInfo.line, dumpInfo.name,
+               ErrorToString(IsAllOk(stack)));
+
+    if (stack == nullptr) return DumpFinish(&buffer, outstream);
+
+    DumpPrintf(&buffer, "work stealing stack <%s> [%p] \"%s\" ",
+               StackElemInfo<T>::NAME, stack, stack->creationInfo.name);
+    DumpPrintf(&buffer, "from %s (%d), %s(): {\n",
+               stack->creationInfo.file,  stack->creationInfo.line, stack->creationInfo.function);
+
+    int64_t size   = stack->size.load(std::memory_order_acquire);
+    int64_t bottom = stack->bottom.load(std::memory_order_acquire);
+    WorkStealingArray<T>* array = stack->array.load(std::memory_order_acquire);
+
+    DumpPrintf(&buffer, "size     = %lld\n",   (long long)size);
+    DumpPrintf(&buffer, "bottom   = %lld\n",   (long long)bottom);
+
+    DumpPrintf(&buffer, "Stack canaries:\n");
+    DumpPrintf(&buffer, "    canaryLeft[%p] = %ud (%s)\n",
+               &stack->canaryLeft,  stack->canaryLeft,  (stack->canaryLeft  == CANARY) ?
+               "Ok" : "IRRUPTION");
+    DumpPrintf(&buffer, "    canaryRight[%p] = %ud (%s)\n\n",
+               &stack->canaryRight, stack->canaryRight, (stack->canaryRight == CANARY) ?
+               "Ok" : "IRRUPTION");
+
+    if (array == nullptr) {
+        DumpPrintf(&buffer, "data[nullptr]\n");
+        return DumpFinish(&buffer, outstream);
+    }
+
+    DumpPrintf(&buffer, "capacity = %lld\n\n", (long long)array->capacity);
+
+    canary* leftDataCanaryLocation  = (canary*)(array->data - GetShift(MID_LEVEL));
+    canary* rightDataCanaryLocation = (canary*)(array->data + array->capacity * sizeof(T));
+    DumpPrintf(&buffer, "Data canaries:\n");
+    DumpPrintf(&buffer, "    canaryLeft[%p] = %ud (%s)\n",
+               leftDataCanaryLocation,  *leftDataCanaryLocation,  (*leftDataCanaryLocation  == CANARY) ?
+               "Ok" : "IRRUPTION");
+    DumpPrintf(&buffer, "    canaryRight[%p] = %ud (%s)\n\n",
+               rightDataCanaryLocation, *rightDataCanaryLocation, (*rightDataCanaryLocation == CANARY) ?
+               "Ok" : "IRRUPTION");
+
+    DumpPrintf(&buffer, "data[%p]\n{\n", array->data);
+
+    if (size - bottom <= array->capacity) {
+        for (int64_t curIdx = bottom; curIdx < size; curIdx++) {
+            T* curElement = GetWorkStealingElem(array, curIdx);
+
+            DumpPrintf(&buffer, "   *[%lld][%p] = ", (long long)curIdx, curElement);
+            StackElemInfo<T>::Print(&buffer, *curElement);
+            DumpPrintf(&buffer, "\n");
+        }
+    }
+
+    DumpPrintf(&buffer, "}\n");
+
+    return DumpFinish(&buffer, outstream);
+}
+
+#endif